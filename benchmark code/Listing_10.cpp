@@ -0,0 +1,56 @@
+/* Listing 10: Random tile norms of Listing 3 over different storage layouts */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixView.hpp"
+#include "../include/LayoutMatrix.hpp"
+
+
+template <typename Layout>
+static double timeLayout(const Matrix &m, const std::vector<std::vector<int>> &tiles, double &sum) {
+	LayoutMatrix<Layout> lm(m);
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const std::vector<int> &t : tiles)
+		sum += lm.view(t[0], t[1], t[2], t[3]).frobeniusNorm();
+	auto stop = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+}
+
+void ft_listing_10() {
+	constexpr int N = 6000;
+	constexpr int M = 1000;
+	constexpr int TILES = 1000;
+	Matrix m(N, N);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	for (int i = 0; i < N; ++i)
+		for (int j = 0; j < N; ++j)
+			m(i, j) = dist(eng);
+
+	std::uniform_int_distribution<int> startdist(0, N - M), spandist(1, M);
+	std::vector<std::vector<int>> tiles;
+	for (int t = 0; t < TILES; ++t)
+		tiles.push_back({startdist(eng), startdist(eng), spandist(eng), spandist(eng)});
+
+	double sums[5] = {0, 0, 0, 0, 0};
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const std::vector<int> &t : tiles)
+		sums[0] += MatrixView(m, t[0], t[1], t[2], t[3]).frobeniusNorm();
+	auto stop = std::chrono::high_resolution_clock::now();
+	double t_view = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+	double t_row = timeLayout<RowMajorLayout>(m, tiles, sums[1]);
+	double t_col = timeLayout<ColumnMajorLayout>(m, tiles, sums[2]);
+	double t_blocked = timeLayout<BlockedLayout<32>>(m, tiles, sums[3]);
+	double t_morton = timeLayout<MortonLayout<32>>(m, tiles, sums[4]);
+
+	std::cout << "MatrixView run time = " << t_view << "ms\n"
+		<< "row-major run time = " << t_row << "ms\n"
+		<< "column-major run time = " << t_col << "ms\n"
+		<< "blocked 32x32 run time = " << t_blocked << "ms\n"
+		<< "Morton 32x32 run time = " << t_morton << "ms\n"
+		<< "sums = " << sums[0] << ", " << sums[1] << ", " << sums[2] << ", " << sums[3] << ", " << sums[4] << "\n";
+}
@@ -0,0 +1,52 @@
+/* Listing 11: A million small matrices in a growing std::vector */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "../include/Matrix.hpp"
+
+// counts every operator new of the program, the listing reads it before and after
+static std::atomic<size_t> allocations(0);
+
+void *operator new(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void *p = std::malloc(size > 0 ? size : 1);
+	if (p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+	std::free(p);
+}
+
+static void fillVector(size_t rows, size_t cols, size_t count) {
+	size_t before = allocations.load();
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<Matrix> matrices;
+	for (size_t k = 0; k < count; ++k) {
+		Matrix m(rows, cols, 1.0);
+		matrices.push_back(std::move(m));
+	}
+	double sum = 0.0;
+	for (const Matrix &m : matrices)
+		sum += m.getValue(rows - 1, cols - 1);
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+	std::cout << rows << "x" << cols << ": " << count << " matrices in " << t << "ms, "
+		<< allocations.load() - before << " operator new calls, sum = " << sum << "\n";
+}
+
+void ft_listing_11() {
+	constexpr size_t COUNT = 1000000;
+	std::cout << "sizeof(Matrix) = " << sizeof(Matrix) << "\n";
+	fillVector(4, 4, COUNT);
+	fillVector(5, 5, COUNT);
+}
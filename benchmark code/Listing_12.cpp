@@ -0,0 +1,51 @@
+/* Listing 12: Norms of 200k 8x8 matrices, one Matrix each vs one MatrixBatch */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixBatch.hpp"
+
+
+void ft_listing_12() {
+	constexpr size_t COUNT = 200000;
+	constexpr size_t DIM = 8;
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	std::vector<Matrix> separate;
+	separate.reserve(COUNT);
+	MatrixBatch batch(COUNT, DIM, DIM);
+	for (size_t k = 0; k < COUNT; ++k) {
+		Matrix m(DIM, DIM);
+		BatchMember member = batch.member(k);
+		for (size_t i = 0; i < DIM; ++i)
+			for (size_t j = 0; j < DIM; ++j) {
+				double x = dist(eng);
+				m(i, j) = x;
+				member(i, j) = x;
+			}
+		separate.push_back(std::move(m));
+	}
+
+	double sums[2] = {0, 0};
+	auto start = std::chrono::high_resolution_clock::now();
+	for (Matrix &m : separate) {
+		m.setSumComputed(false);
+		sums[0] += m.frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_separate = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<double> norms = batch.frobeniusNorms();
+	for (double n : norms)
+		sums[1] += n;
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_batch = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "separate matrices norm time = " << t_separate << "ms\n"
+		<< "batched norm time = " << t_batch << "ms\n"
+		<< "sums = " << sums[0] << ", " << sums[1] << "\n";
+}
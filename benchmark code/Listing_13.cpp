@@ -0,0 +1,53 @@
+/* Listing 13: Temporaries of a request on the heap vs in a MatrixArena */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixView.hpp"
+#include "../include/MatrixArena.hpp"
+
+
+// one request: materialize small tiles, copy them, use a scratch matrix
+static double request(Matrix &m, int i, int j) {
+	Matrix scratch(16, 16);
+	double sum = 0.0;
+	for (int k = 0; k < 16; ++k) {
+		Matrix tile = MatrixView(m, i + k, j, 6, 8);
+		Matrix copy = tile;
+		scratch(k, k) = copy.getValue(1, 1);
+		sum += copy.frobeniusNorm();
+	}
+	return sum + scratch.frobeniusNorm();
+}
+
+void ft_listing_13() {
+	constexpr int N = 1000;
+	constexpr int REQUESTS = 100000;
+	Matrix m(N, N, 0.5);
+
+	std::default_random_engine eng(1234);
+	std::uniform_int_distribution<int> startdist(0, N - 100);
+	std::vector<std::pair<int, int>> starts;
+	for (int r = 0; r < REQUESTS; ++r)
+		starts.push_back(std::make_pair(startdist(eng), startdist(eng)));
+
+	double sums[2] = {0, 0};
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < REQUESTS; ++r)
+		sums[0] += request(m, starts[r].first, starts[r].second);
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_heap = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < REQUESTS; ++r) {
+		MatrixArena scope;
+		sums[1] += request(m, starts[r].first, starts[r].second);
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_arena = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "heap request time = " << t_heap * 1e3 / REQUESTS << "us\n"
+		<< "arena request time = " << t_arena * 1e3 / REQUESTS << "us\n"
+		<< "sums = " << sums[0] << ", " << sums[1] << "\n";
+}
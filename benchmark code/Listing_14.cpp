@@ -0,0 +1,46 @@
+/* Listing 14: Repeated scale-then-norm of a 3000x3000 matrix, element writes vs Matrix::scale */
+
+#include <chrono>
+#include <iostream>
+#include "../include/Matrix.hpp"
+
+
+void ft_listing_14() {
+	constexpr size_t DIM = 3000;
+	constexpr int ROUNDS = 10;
+
+	Matrix written(DIM, DIM);
+	for (size_t i = 0; i < DIM; ++i)
+		for (size_t j = 0; j < DIM; ++j)
+			written(i, j) = 1.0 / (1.0 + i + j);
+	Matrix lazy(written);
+	const double factors[2] = {1.5, 0.75};
+
+	double norms[2] = {0, 0};
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < ROUNDS; ++r) {
+		double c = factors[r % 2];
+		for (size_t i = 0; i < DIM; ++i)
+			for (size_t j = 0; j < DIM; ++j)
+				written(i, j) = written.getValue(i, j) * c;
+		written.setSumComputed(false);
+		norms[0] += written.frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_written = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < ROUNDS; ++r) {
+		lazy.scale(factors[r % 2]);
+		norms[1] += lazy.frobeniusNorm();
+	}
+	// the rows themselves, once
+	double corner = lazy.getMatrix()[DIM - 1][DIM - 1];
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_lazy = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "element writes + rescan time = " << t_written << "ms\n"
+		<< "lazy scale + O(1) norm time = " << t_lazy << "ms\n"
+		<< "norms = " << norms[0] << ", " << norms[1]
+		<< ", corners = " << written.getValue(DIM - 1, DIM - 1) << ", " << corner << "\n";
+}
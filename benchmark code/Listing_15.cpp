@@ -0,0 +1,46 @@
+/* Listing 15: Copying and clearing a 2000x2000 tile, element by element vs assign() and fill() */
+
+#include <chrono>
+#include <iostream>
+#include "../include/Matrix.hpp"
+#include "../include/viewAssign.hpp"
+
+
+void ft_listing_15() {
+	constexpr size_t DIM = 2500;
+	constexpr size_t TILE = 2000;
+
+	Matrix src(DIM, DIM);
+	for (size_t i = 0; i < DIM; ++i)
+		for (size_t j = 0; j < DIM; ++j)
+			src(i, j) = 1.0 / (1.0 + i + j);
+	Matrix perElement(DIM, DIM, 1.0);
+	Matrix bulk(DIM, DIM, 1.0);
+	perElement.frobeniusNorm();
+	bulk.frobeniusNorm();
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < TILE; ++i)
+		for (size_t j = 0; j < TILE; ++j)
+			perElement(100 + i, 200 + j) = src.getValue(300 + i, 400 + j);
+	for (size_t i = 0; i < TILE; ++i)
+		for (size_t j = 0; j < TILE / 2; ++j)
+			perElement(i, j) = 0.0;
+	double normElement = perElement.frobeniusNorm();
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_element = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	MatrixView from(src, 300, 400, TILE, TILE);
+	MatrixView to(bulk, 100, 200, TILE, TILE);
+	assign(to, from);
+	MatrixView cleared(bulk, 0, 0, TILE, TILE / 2);
+	fill(cleared, 0.0);
+	double normBulk = bulk.frobeniusNorm();
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_bulk = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "element-wise copy + clear time = " << t_element << "ms\n"
+		<< "assign + fill time = " << t_bulk << "ms\n"
+		<< "norms = " << normElement << ", " << normBulk << "\n";
+}
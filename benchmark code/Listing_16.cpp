@@ -0,0 +1,53 @@
+/* Listing 16: Norm and materialization of a shuffled half of the rows of a 100000x64 matrix, copies vs IndexedView */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/IndexedView.hpp"
+
+
+void ft_listing_16() {
+	constexpr size_t ROWS = 100000;
+	constexpr size_t COLS = 64;
+	constexpr size_t PICKED = ROWS / 2;
+
+	Matrix m(ROWS, COLS);
+	double **rows = m.getRawMatrix();
+	for (size_t i = 0; i < ROWS; ++i)
+		for (size_t j = 0; j < COLS; ++j)
+			rows[i][j] = 1.0 / (1.0 + i + j);
+	m.markWritten(0, ROWS);
+	std::vector<size_t> order(ROWS);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), std::default_random_engine(1234));
+	order.resize(PICKED);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	Matrix copied(PICKED, COLS);
+	for (size_t i = 0; i < PICKED; ++i)
+		for (size_t j = 0; j < COLS; ++j)
+			copied(i, j) = m.getValue(order[i], j);
+	double normCopied = copied.frobeniusNorm();
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_copied = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	IndexedView picked = IndexedView::selectRows(m, order);
+	double normView = picked.frobeniusNorm();
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_view = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	Matrix gathered = picked.toMatrix();
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_gather = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "element-wise copy + norm time = " << t_copied << "ms\n"
+		<< "IndexedView norm time = " << t_view << "ms\n"
+		<< "IndexedView gather time = " << t_gather << "ms\n"
+		<< "norms = " << normCopied << ", " << normView << ", " << gathered.frobeniusNorm() << "\n";
+}
@@ -0,0 +1,61 @@
+/* Listing 17: Distances from one 256x256 tile to 200 others, difference matrices vs frobeniusDistances */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/frobeniusNorm.hpp"
+
+
+void ft_listing_17() {
+	constexpr size_t DIM = 2048;
+	constexpr size_t TILE = 256;
+	constexpr size_t COUNT = 200;
+
+	Matrix m(DIM, DIM);
+	double **rows = m.getRawMatrix();
+	for (size_t i = 0; i < DIM; ++i)
+		for (size_t j = 0; j < DIM; ++j)
+			rows[i][j] = 1.0 / (1.0 + i + 3 * j);
+	m.markWritten(0, DIM);
+	MatrixView ref(m, 0, 0, TILE, TILE);
+	std::vector<MatrixView> others;
+	for (size_t k = 0; k < COUNT; ++k)
+		others.push_back(MatrixView(m, (k * 97) % (DIM - TILE), (k * 61) % (DIM - TILE), TILE, TILE));
+
+	std::vector<double> viaDifference(COUNT);
+	auto start = std::chrono::high_resolution_clock::now();
+	for (size_t k = 0; k < COUNT; ++k) {
+		Matrix diff = ref;
+		for (size_t i = 0; i < TILE; ++i)
+			for (size_t j = 0; j < TILE; ++j)
+				diff(i, j) = diff.getValue(i, j) - others[k].getValue(i, j);
+		diff.setSumComputed(false);
+		viaDifference[k] = diff.frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_difference = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<double> pairwise(COUNT);
+	for (size_t k = 0; k < COUNT; ++k)
+		pairwise[k] = frobeniusDistance(ref, others[k]);
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_pairwise = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<double> batched = frobeniusDistances(ref, others);
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_batched = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	double sums[3] = {0, 0, 0};
+	for (size_t k = 0; k < COUNT; ++k) {
+		sums[0] += viaDifference[k];
+		sums[1] += pairwise[k];
+		sums[2] += batched[k];
+	}
+	std::cout << "difference matrix + norm time = " << t_difference << "ms\n"
+		<< "frobeniusDistance time = " << t_pairwise << "ms\n"
+		<< "frobeniusDistances time = " << t_batched << "ms\n"
+		<< "sums = " << sums[0] << ", " << sums[1] << ", " << sums[2] << "\n";
+}
@@ -1,6 +1,7 @@
 /* Listing 2: Demonstration of MatrixView behaviour */
 
 #include <iostream>
+#include <memory>
 #include "../include/Matrix.hpp"
 #include "../include/MatrixView.hpp"
 void f(const Matrix &m)
@@ -0,0 +1,50 @@
+/* Listing 4: Listing 3 with the tile queries pipelined behind the fill */
+
+#include <random>
+#include <chrono>
+#include <iostream>
+#include "../include/Matrix.hpp"
+#include "../include/TilePipeline.hpp"
+
+
+void ft_listing_4() {
+	constexpr int N = 10000;
+	constexpr int M = 1000;
+	constexpr int PUBLISH_EVERY = 64;
+	Matrix m(N, N);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	// tiles come from their own engine so they can be drawn before the fill
+	std::default_random_engine tileEng(1234);
+	std::uniform_int_distribution<int> startdist(0, N - M), spandist(1, M);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	TilePipeline pipeline(m);
+	for (int i = 0; i < 1000; ++i) {
+		int starti = startdist(tileEng);
+		int startj = startdist(tileEng);
+		int spani = spandist(tileEng);
+		int spanj = spandist(tileEng);
+		pipeline.submit(starti, startj, spani, spanj);
+	}
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			m(i, j) = dist(eng);
+		}
+		if ((i + 1) % PUBLISH_EVERY == 0)
+			pipeline.publishRows(i + 1);
+	}
+	pipeline.finish();
+	auto filled = std::chrono::high_resolution_clock::now();
+
+	double sum = 0.0;
+	std::vector<double> norms = pipeline.results();
+	for (size_t i = 0; i < norms.size(); ++i)
+		sum += norms[i];
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_init = std::chrono::duration_cast<std::chrono::microseconds>(filled - start).count() * 1e-3;
+	auto t_total = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "pipelined init time = " << t_init << "ms\n" << "pipelined total time = " << t_total << "ms\n" << "sum = " << sum << "\n";
+}
@@ -0,0 +1,49 @@
+/* Listing 5: Bandwidth of the matrix-vector product against a plain streaming read */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/frobeniusNorm.hpp"
+#include "../include/gemv.hpp"
+
+
+void ft_listing_5() {
+	constexpr int N = 8000;
+	constexpr int REPEAT = 10;
+	Matrix m(N, N, 0.5);
+	std::vector<double> x(N, 1.0), y(N);
+	double bytes = static_cast<double>(N) * N * sizeof(double) * REPEAT;
+
+	// streaming read of the whole matrix: the practical bandwidth ceiling
+	double sink = 0.0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < REPEAT; ++r) {
+		m.setSumComputed(false);
+		sink += frobeniusNorm(m);
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	double t_read = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-6;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < REPEAT; ++r) {
+		gemv(m, x, y);
+		sink += y[r];
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	double t_gemv = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-6;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int r = 0; r < REPEAT; ++r) {
+		gemv(m, x, y, 1.0, 0.0, true);
+		sink += y[r];
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	double t_gemvt = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-6;
+
+	std::cout << "streaming read = " << bytes / t_read * 1e-9 << " GB/s\n"
+		<< "gemv = " << bytes / t_gemv * 1e-9 << " GB/s\n"
+		<< "gemv transposed = " << bytes / t_gemvt * 1e-9 << " GB/s\n"
+		<< "sink = " << sink << "\n";
+}
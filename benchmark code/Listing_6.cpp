@@ -0,0 +1,66 @@
+/* Listing 6: Spectral norm estimates of tiles next to the Frobenius path */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixView.hpp"
+#include "../include/spectralNorm.hpp"
+
+
+void ft_listing_6() {
+	constexpr int N = 2000;
+	constexpr int M = 200;
+	constexpr int TILES = 100;
+	Matrix m(N, N);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(0.0, 1.0);
+	for (int i = 0; i < N; ++i)
+		for (int j = 0; j < N; ++j)
+			m(i, j) = dist(eng);
+
+	// neighbouring tiles of the same size, as in a sliding scan
+	std::uniform_int_distribution<int> startdist(0, N - M - TILES);
+	int starti = startdist(eng);
+	int startj = startdist(eng);
+
+	double frob = 0.0, spectral = 0.0, warmSpectral = 0.0;
+	size_t coldIter = 0, warmIter = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TILES; ++t) {
+		MatrixView mv(m, starti + t, startj + t, M, M);
+		frob += mv.frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_frob = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TILES; ++t) {
+		MatrixView mv(m, starti + t, startj + t, M, M);
+		SpectralEstimate e = spectralNormEstimate(mv, 1e-8, 500, std::vector<double>());
+		spectral += e.value;
+		coldIter += e.iterations;
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_cold = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::vector<double> previous;
+	start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TILES; ++t) {
+		MatrixView mv(m, starti + t, startj + t, M, M);
+		SpectralEstimate e = spectralNormEstimate(mv, 1e-8, 500, previous);
+		warmSpectral += e.value;
+		warmIter += e.iterations;
+		previous = e.rightVector;
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_warm = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "frobenius time per tile = " << t_frob / TILES << "ms\n"
+		<< "spectral time per tile = " << t_cold / TILES << "ms, "
+		<< static_cast<double>(coldIter) / TILES << " iterations\n"
+		<< "warm-started spectral time per tile = " << t_warm / TILES << "ms, "
+		<< static_cast<double>(warmIter) / TILES << " iterations\n"
+		<< "sums = " << frob << ", " << spectral << ", " << warmSpectral << "\n";
+}
@@ -0,0 +1,51 @@
+/* Listing 7: Tile norms of a 99% sparse matrix, dense scan vs CSR */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixView.hpp"
+#include "../include/SparseMatrix.hpp"
+
+
+void ft_listing_7() {
+	constexpr int N = 4000;
+	constexpr int M = 1000;
+	constexpr int TILES = 100;
+	Matrix m(N, N);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(0.0, 1.0);
+	for (int i = 0; i < N; ++i)
+		for (int j = 0; j < N; ++j)
+			if (dist(eng) < 0.01)
+				m(i, j) = dist(eng);
+	SparseMatrix sparse(m);
+
+	std::uniform_int_distribution<int> startdist(0, N - M);
+	std::vector<std::pair<int, int>> starts;
+	for (int t = 0; t < TILES; ++t)
+		starts.push_back(std::make_pair(startdist(eng), startdist(eng)));
+
+	double dense = 0.0, compressed = 0.0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TILES; ++t) {
+		MatrixView mv(m, starts[t].first, starts[t].second, M, M);
+		dense += mv.frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_dense = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TILES; ++t) {
+		SparseMatrixView sv = sparse.view(starts[t].first, starts[t].second, M, M);
+		compressed += sv.frobeniusNorm();
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_sparse = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "non-zeros = " << sparse.getNonZeros() << " of " << static_cast<size_t>(N) * N << "\n"
+		<< "dense tile norm time = " << t_dense / TILES << "ms\n"
+		<< "sparse tile norm time = " << t_sparse / TILES << "ms\n"
+		<< "sums = " << dense << ", " << compressed << "\n";
+}
@@ -0,0 +1,44 @@
+/* Listing 8: Norm of a sliding window after every pushed row */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include "../include/RingMatrix.hpp"
+
+
+void ft_listing_8() {
+	constexpr int WINDOW = 1000;
+	constexpr int COLS = 64;
+	constexpr int TICKS = 20000;
+	RingMatrix ring(WINDOW, COLS);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(0.0, 1.0);
+	std::vector<double> row(COLS);
+
+	double rescanned = 0.0, rolling = 0.0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TICKS; ++t) {
+		for (int j = 0; j < COLS; ++j)
+			row[j] = dist(eng);
+		ring.push(row);
+		rescanned += ring.view().frobeniusNorm();
+	}
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto t_rescan = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	ring.clear();
+	start = std::chrono::high_resolution_clock::now();
+	for (int t = 0; t < TICKS; ++t) {
+		for (int j = 0; j < COLS; ++j)
+			row[j] = dist(eng);
+		ring.push(row);
+		rolling += ring.frobeniusNorm();
+	}
+	stop = std::chrono::high_resolution_clock::now();
+	auto t_rolling = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+
+	std::cout << "rescanned window norm time per tick = " << t_rescan * 1e3 / TICKS << "us\n"
+		<< "rolling window norm time per tick = " << t_rolling * 1e3 / TICKS << "us\n"
+		<< "sums = " << rescanned << ", " << rolling << "\n";
+}
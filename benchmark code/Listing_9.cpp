@@ -0,0 +1,55 @@
+/* Listing 9: Tile norms over double, float and bfloat16 storage */
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixView.hpp"
+#include "../include/CompactMatrix.hpp"
+
+
+template <typename Tile>
+static double timeTiles(const std::vector<std::vector<int>> &tiles, double &sum, Tile tile) {
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const std::vector<int> &t : tiles)
+		sum += tile(t[0], t[1], t[2], t[3]);
+	auto stop = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() * 1e-3;
+}
+
+void ft_listing_9() {
+	constexpr int N = 6000;
+	constexpr int M = 3000;
+	constexpr int TILES = 200;
+	Matrix m(N, N);
+
+	std::default_random_engine eng(1234);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	for (int i = 0; i < N; ++i)
+		for (int j = 0; j < N; ++j)
+			m(i, j) = dist(eng);
+	CompactMatrix<float> single(m);
+	CompactMatrix<bfloat16> brain(m);
+
+	std::uniform_int_distribution<int> startdist(0, N - M), spandist(1, M);
+	std::vector<std::vector<int>> tiles;
+	for (int t = 0; t < TILES; ++t)
+		tiles.push_back({startdist(eng), startdist(eng), spandist(eng), spandist(eng)});
+
+	double sums[3] = {0, 0, 0};
+	double t_double = timeTiles(tiles, sums[0], [&](int i, int j, int r, int c) {
+		return MatrixView(m, i, j, r, c).frobeniusNorm();
+	});
+	double t_float = timeTiles(tiles, sums[1], [&](int i, int j, int r, int c) {
+		return single.view(i, j, r, c).frobeniusNorm();
+	});
+	double t_bf16 = timeTiles(tiles, sums[2], [&](int i, int j, int r, int c) {
+		return brain.view(i, j, r, c).frobeniusNorm();
+	});
+
+	std::cout << "double tile norm time = " << t_double << "ms\n"
+		<< "float tile norm time = " << t_float << "ms\n"
+		<< "bfloat16 tile norm time = " << t_bf16 << "ms\n"
+		<< "sums = " << sums[0] << ", " << sums[1] << ", " << sums[2] << "\n";
+}
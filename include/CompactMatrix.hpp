@@ -0,0 +1,144 @@
+#ifndef COMPACTMATRIX_HPP
+#define COMPACTMATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "ThreadPool.hpp"
+#include "lowPrecision.hpp"
+#include "reduce.hpp"
+
+template <typename T>
+class CompactMatrixView;
+
+/*
+	Matrix stored in a narrower format: float, bfloat16 or float16 (see
+	lowPrecision.hpp), one contiguous row-major block. Tile scans move
+	1/2 or 1/4 of the bytes of a double Matrix.
+
+	Values are rounded once, when they are stored. Everything read back is
+	widened to double first, and norms and reductions accumulate in double,
+	so they are exact for the stored values up to double rounding.
+
+	The cached sum of squares follows setValue() with the delta of the
+	stored (rounded) values. Instantiated for float, bfloat16 and float16.
+*/
+template <typename T>
+class CompactMatrix {
+	private:
+		size_t			rows;
+		size_t			cols;
+		std::vector<T>	data;
+		mutable double	sum;
+		mutable bool	sumComputed;
+
+		void	narrowFrom(double **source, size_t startRow, size_t startCol, double scale = 1.0);
+
+	public:
+		CompactMatrix(size_t rows, size_t cols);
+		// bulk conversions, rows are narrowed in parallel
+		explicit CompactMatrix(const Matrix &source);
+		explicit CompactMatrix(const MatrixView &source);
+
+		size_t	getRows() const;
+		size_t	getCols() const;
+		// bytes of element storage
+		size_t	getBytes() const;
+		const T	*getRow(size_t row) const;
+
+		// throws std::out_of_range
+		double	getValue(size_t row, size_t col) const;
+		void	setValue(size_t row, size_t col, double value);
+
+		Matrix	toMatrix() const;
+		double	frobeniusNorm() const;
+
+		// throws std::out_of_range if the tile exceeds the matrix
+		CompactMatrixView<T>	view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const;
+};
+
+/*
+	Rectangular tile of a CompactMatrix. Like MatrixView, the norm is
+	cached on first use and not refreshed by later writes to the matrix.
+*/
+template <typename T>
+class CompactMatrixView {
+	private:
+		const CompactMatrix<T>	&matrix;
+		size_t					rows;
+		size_t					cols;
+		size_t					startRow;
+		size_t					startCol;
+		mutable double			sum;
+		mutable bool			sumComputed;
+
+	public:
+		CompactMatrixView(const CompactMatrix<T> &matrix, size_t startRow, size_t startCol,
+			size_t numRows, size_t numCols);
+
+		const CompactMatrix<T>	&getMatrix() const;
+		size_t	getRows() const;
+		size_t	getCols() const;
+		size_t	getStartRow() const;
+		size_t	getStartCol() const;
+		// first element of the tile's row
+		const T	*getRow(size_t row) const;
+
+		double	getValue(size_t row, size_t col) const;
+		double	frobeniusNorm() const;
+		Matrix	toMatrix() const;
+};
+
+extern template class CompactMatrix<float>;
+extern template class CompactMatrix<bfloat16>;
+extern template class CompactMatrix<float16>;
+extern template class CompactMatrixView<float>;
+extern template class CompactMatrixView<bfloat16>;
+extern template class CompactMatrixView<float16>;
+
+/*
+	reduce() over compact storage: every span is widened into an L1-sized
+	double buffer and handed to the same reducers as the double version.
+*/
+template <typename T, typename... R>
+std::tuple<typename R::Result...> reduce(const CompactMatrixView<T> &view, R... reducers)
+{
+	typedef std::tuple<typename R::State...> States;
+	typedef std::index_sequence_for<R...> Indices;
+	std::tuple<R...> all(reducers...);
+	States identity(reducers.init()...);
+	size_t numCols = view.getCols();
+
+	States total = ThreadPool::instance().parallelReduce(0, view.getRows(), numCols, identity,
+		[&](size_t lo, size_t hi) {
+			States states = identity;
+			double span[reduce_detail::SPAN];
+			for (size_t i = lo; i < hi; i++)
+			{
+				const T *row = view.getRow(i);
+				for (size_t j = 0; j < numCols; j += reduce_detail::SPAN)
+				{
+					size_t n = std::min(reduce_detail::SPAN, numCols - j);
+					widenSpan(span, row + j, n);
+					reduce_detail::accumulateAll(all, states, span, n, Indices());
+				}
+			}
+			return states;
+		},
+		[&](States a, const States &b) {
+			reduce_detail::mergeAll(all, a, b, Indices());
+			return a;
+		});
+	return reduce_detail::finishAll(all, total, view.getRows() * numCols, Indices());
+}
+
+template <typename T, typename... R>
+std::tuple<typename R::Result...> reduce(const CompactMatrix<T> &m, R... reducers)
+{
+	return reduce(m.view(0, 0, m.getRows(), m.getCols()), reducers...);
+}
+
+#endif
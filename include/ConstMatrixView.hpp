@@ -0,0 +1,43 @@
+#ifndef CONSTMATRIXVIEW_HPP
+#define CONSTMATRIXVIEW_HPP
+
+#include <cstddef>
+#include "Matrix.hpp"
+
+/*
+	Read-only tile of a Matrix whose rows belong to someone else, such as
+	a VersionedMatrix snapshot (blocks shared with other versions) or a
+	RingMatrix window (rows behind its running sums).
+
+	Unlike a MatrixView it has no write path and cannot be turned into
+	one, so copying it never gives access to the rows. It reads them as
+	stored and applies the matrix's pending scale, leaving the matrix
+	untouched. It is valid as long as the rows it was created over.
+	Out-of-range tiles and indices throw std::out_of_range.
+*/
+class ConstMatrixView {
+	private:
+		double			**table;	// only read
+		double			scale;
+		size_t			rows;
+		size_t			cols;
+		size_t			startRow;
+		size_t			startCol;
+		mutable double	sum;
+		mutable bool	sumComputed;
+
+	public:
+		ConstMatrixView(const Matrix &matrix, size_t startRow, size_t startCol, size_t numRows, size_t numCols);
+
+		size_t	getRows() const;
+		size_t	getCols() const;
+		size_t	getStartRow() const;
+		size_t	getStartCol() const;
+
+		double	getValue(size_t row, size_t col) const;
+		double	operator()(size_t row, size_t col) const;
+		double	frobeniusNorm() const;
+		Matrix	toMatrix() const;
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef FUTURE_HPP
+#define FUTURE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "ThreadPool.hpp"
+
+/*
+	Thrown from Future::get() when the operation was cancelled before it
+	finished.
+*/
+class OperationCancelled : public std::runtime_error {
+	public:
+		OperationCancelled() : std::runtime_error("Operation cancelled") {}
+};
+
+/*
+	Shared cancellation flag. Long-running kernels poll it between chunks
+	of rows; every stage of a then() chain shares the token of its source.
+*/
+class CancellationToken {
+	private:
+		std::shared_ptr<std::atomic<bool>> flag;
+
+	public:
+		CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+		void	cancel() const { flag->store(true, std::memory_order_relaxed); }
+		bool	isCancelled() const { return flag->load(std::memory_order_relaxed); }
+		void	throwIfCancelled() const
+		{
+			if (isCancelled())
+				throw OperationCancelled();
+		}
+};
+
+template <typename T>
+class Promise;
+
+namespace future_detail {
+
+template <typename T>
+struct State {
+	std::mutex				mutex;
+	std::condition_variable	done;
+	bool					ready = false;
+	std::optional<T>		value;
+	std::exception_ptr		error;
+	std::function<void()>	continuation;
+};
+
+// Future<void>: nothing to keep, ready is the whole result
+template <>
+struct State<void> {
+	std::mutex				mutex;
+	std::condition_variable	done;
+	bool					ready = false;
+	std::exception_ptr		error;
+	std::function<void()>	continuation;
+};
+
+// result type of a continuation f of Future<T>
+template <typename F, typename T>
+struct Continued {
+	typedef std::invoke_result_t<F, T> type;
+};
+
+template <typename F>
+struct Continued<F, void> {
+	typedef std::invoke_result_t<F> type;
+};
+
+// f applied to the value held by s, to nothing for Future<void>
+template <typename F, typename T>
+decltype(auto) invokeWith(F &f, State<T> &s)
+{
+	if constexpr (std::is_void_v<T>)
+		return f();
+	else
+		return f(std::move(*s.value));
+}
+
+// next completed with the result of g(), also when g returns void
+template <typename U, typename G>
+void fulfil(const Promise<U> &next, G g)
+{
+	if constexpr (std::is_void_v<U>)
+	{
+		g();
+		next.setValue();
+	}
+	else
+		next.setValue(g());
+}
+
+}
+
+/*
+	One-shot result of an asynchronous operation.
+
+	get() blocks and moves the value out (or rethrows the error).
+	then() consumes the future and schedules a continuation on the thread
+	pool once the value is there, returning the future of its result.
+	Future<void> carries completion only: its continuations take no
+	argument, and a continuation returning void gives a Future<void>.
+*/
+template <typename T>
+class Future {
+	private:
+		typedef future_detail::State<T> State;
+
+		std::shared_ptr<State>	state;
+		CancellationToken		token;
+
+		friend class Promise<T>;
+		Future(std::shared_ptr<State> state, CancellationToken token) : state(state), token(token) {}
+
+	public:
+		Future() {}
+
+		bool	valid() const { return state != nullptr; }
+		CancellationToken	getToken() const { return token; }
+		void	cancel() const { token.cancel(); }
+		bool	isCancelled() const { return token.isCancelled(); }
+
+		bool	isReady() const
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			return state->ready;
+		}
+
+		void	wait() const
+		{
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->done.wait(lock, [this]() { return state->ready; });
+		}
+
+		T		get()
+		{
+			wait();
+			std::shared_ptr<State> s = std::move(state);
+			if (s->error)
+				std::rethrow_exception(s->error);
+			if constexpr (!std::is_void_v<T>)
+				return std::move(*s->value);
+		}
+
+		template <typename F>
+		Future<typename future_detail::Continued<F, T>::type>	then(F f, ThreadPool &pool = ThreadPool::instance())
+		{
+			typedef typename future_detail::Continued<F, T>::type U;
+			Promise<U> next(token);
+			Future<U> result = next.getFuture();
+			std::shared_ptr<State> s = std::move(state);
+			CancellationToken tok = token;
+			ThreadPool *p = &pool;
+
+			std::function<void()> continuation = [s, tok, f, next, p]() {
+				p->submit([s, tok, f, next]() mutable {
+					try
+					{
+						if (s->error)
+							std::rethrow_exception(s->error);
+						tok.throwIfCancelled();
+						future_detail::fulfil(next, [&]() { return future_detail::invokeWith(f, *s); });
+					}
+					catch (...)
+					{
+						next.setException(std::current_exception());
+					}
+				});
+			};
+
+			std::unique_lock<std::mutex> lock(s->mutex);
+			if (s->ready)
+			{
+				lock.unlock();
+				continuation();
+			}
+			else
+				s->continuation = continuation;
+			return result;
+		}
+};
+
+/*
+	Producer side of a Future.
+*/
+template <typename T>
+class Promise {
+	private:
+		std::shared_ptr<future_detail::State<T>>	state;
+		CancellationToken							token;
+
+		void	complete() const
+		{
+			std::function<void()> continuation;
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->ready = true;
+				continuation.swap(state->continuation);
+			}
+			state->done.notify_all();
+			if (continuation)
+				continuation();
+		}
+
+	public:
+		explicit Promise(CancellationToken token = CancellationToken())
+			: state(std::make_shared<future_detail::State<T>>()), token(token) {}
+
+		Future<T>	getFuture() const { return Future<T>(state, token); }
+		CancellationToken	getToken() const { return token; }
+
+		// the value, or no argument for Promise<void>
+		template <typename... V>
+		void	setValue(V &&...value) const
+		{
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				if constexpr (!std::is_void_v<T>)
+					state->value.emplace(std::forward<V>(value)...);
+			}
+			complete();
+		}
+
+		void	setException(std::exception_ptr error) const
+		{
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->error = error;
+			}
+			complete();
+		}
+};
+
+/*
+	Runs f(token) on the pool and returns the future of its result.
+*/
+template <typename F>
+Future<std::invoke_result_t<F, CancellationToken>>	runAsync(F f, ThreadPool &pool = ThreadPool::instance())
+{
+	typedef std::invoke_result_t<F, CancellationToken> T;
+	Promise<T> promise;
+	Future<T> future = promise.getFuture();
+	pool.submit([promise, f]() mutable {
+		try
+		{
+			CancellationToken token = promise.getToken();
+			token.throwIfCancelled();
+			future_detail::fulfil(promise, [&]() { return f(token); });
+		}
+		catch (...)
+		{
+			promise.setException(std::current_exception());
+		}
+	});
+	return future;
+}
+
+#endif
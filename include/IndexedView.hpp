@@ -0,0 +1,86 @@
+#ifndef INDEXEDVIEW_HPP
+#define INDEXEDVIEW_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	View of the rows and columns of a matrix or tile picked by index:
+
+		view(i, j) = parent(rowIndex[i], colIndex[j])
+
+	Nothing is copied: the view keeps its own table of row pointers into
+	the parent's rows (as a Matrix does over its blocks) and reads the
+	columns through colIndex. Indices may repeat and come in any order,
+	so the same class covers row pivoting, shuffles and subset selection.
+	With every column in order (allColumns), each row is one contiguous
+	span and the kernels run over it as over a tile.
+
+	Norms and toMatrix() walk the rows through the gather kernels, which
+	prefetch the upcoming indexed rows so a large reordering streams about
+	as well as a tile. A permutation of every row (and column) of a whole
+	matrix has the parent's norm, which it takes in O(1) when cached.
+
+	setValue() keeps the view's and the parent's sums in step. Like a
+	tile view, the view keeps the parent's rows alive; it does not follow
+	the parent through later growth or reshapes.
+	Out-of-range indices throw std::out_of_range, index arrays that are
+	not permutations throw std::invalid_argument in the permutation
+	factories.
+*/
+class IndexedView {
+	private:
+		Matrix							&matrix;
+		std::shared_ptr<MatrixStorage>	storage;
+		std::vector<double *>			rowPtrs;	// first selected column already added when allColumns
+		std::vector<size_t>				rowIndex;	// rows of the parent matrix
+		std::vector<size_t>				colIndex;	// columns of the parent matrix, empty when allColumns
+		size_t							numCols;
+		size_t							firstCol;	// parent column of view column 0 when contiguous
+		bool							contiguous;
+		bool							distinct;	// no parent element appears twice
+		mutable double					sum;
+		mutable bool					sumComputed;
+
+		// tile NULL for the whole matrix, cols NULL for every column of it
+		IndexedView(Matrix &matrix, const MatrixView *tile, const std::vector<size_t> &rows,
+			const std::vector<size_t> *cols);
+
+	public:
+		// rows x cols selection of a matrix / of a tile, indices relative to it
+		IndexedView(Matrix &matrix, const std::vector<size_t> &rows, const std::vector<size_t> &cols);
+		IndexedView(const MatrixView &tile, const std::vector<size_t> &rows, const std::vector<size_t> &cols);
+
+		// every column, in order
+		static IndexedView	selectRows(Matrix &matrix, const std::vector<size_t> &rows);
+		static IndexedView	selectRows(const MatrixView &tile, const std::vector<size_t> &rows);
+		// every row, in order
+		static IndexedView	selectCols(Matrix &matrix, const std::vector<size_t> &cols);
+
+		// row i of the view is row perm[i]; perm must be a permutation
+		static IndexedView	permuteRows(Matrix &matrix, const std::vector<size_t> &perm);
+		static IndexedView	permuteCols(Matrix &matrix, const std::vector<size_t> &perm);
+		static IndexedView	permute(Matrix &matrix, const std::vector<size_t> &rowPerm,
+								const std::vector<size_t> &colPerm);
+
+		size_t	getRows() const;
+		size_t	getCols() const;
+		bool	allColumns() const;
+		// row / column of the parent matrix behind row i / column j of the view
+		size_t	parentRow(size_t i) const;
+		size_t	parentCol(size_t j) const;
+
+		// throws std::out_of_range
+		double	getValue(size_t row, size_t col) const;
+		void	setValue(size_t row, size_t col, double value);
+
+		double	frobeniusNorm() const;
+		// gathered into a new matrix, the cached sum carries over
+		Matrix	toMatrix() const;
+		operator Matrix() const;
+};
+
+#endif
@@ -0,0 +1,340 @@
+#ifndef LAYOUTMATRIX_HPP
+#define LAYOUTMATRIX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+#include "rowKernels.hpp"
+
+/*
+	Storage layouts for LayoutMatrix.
+
+	A layout maps (row, col) to an offset into one contiguous block and
+	enumerates the contiguous runs covering a tile: forEachSpan() calls
+	f(offset, length) for each of them. That is all the access and norm
+	code needs, and since the layout is a template parameter every call
+	is inlined for it.
+
+	columnPanels tells the tile kernels to split work by columns instead
+	of rows, so that each thread still walks whole runs.
+*/
+
+class RowMajorLayout {
+	private:
+		size_t	rows;
+		size_t	cols;
+
+	public:
+		static const bool columnPanels = false;
+
+		RowMajorLayout(size_t rows, size_t cols) : rows(rows), cols(cols) {}
+
+		size_t	size() const { return this->rows * this->cols; }
+		size_t	offset(size_t row, size_t col) const { return row * this->cols + col; }
+
+		template <typename F>
+		void	forEachSpan(size_t startRow, size_t startCol, size_t numRows, size_t numCols, F f) const
+		{
+			if (numCols == this->cols)
+			{
+				f(offset(startRow, 0), numRows * numCols);
+				return;
+			}
+			for (size_t i = startRow; i < startRow + numRows; i++)
+				f(offset(i, startCol), numCols);
+		}
+};
+
+class ColumnMajorLayout {
+	private:
+		size_t	rows;
+		size_t	cols;
+
+	public:
+		static const bool columnPanels = true;
+
+		ColumnMajorLayout(size_t rows, size_t cols) : rows(rows), cols(cols) {}
+
+		size_t	size() const { return this->rows * this->cols; }
+		size_t	offset(size_t row, size_t col) const { return col * this->rows + row; }
+
+		template <typename F>
+		void	forEachSpan(size_t startRow, size_t startCol, size_t numRows, size_t numCols, F f) const
+		{
+			if (numRows == this->rows)
+			{
+				f(offset(0, startCol), numRows * numCols);
+				return;
+			}
+			for (size_t j = startCol; j < startCol + numCols; j++)
+				f(offset(startRow, j), numRows);
+		}
+};
+
+/*
+	Block orders for TiledLayout: the key of block (blockRow, blockCol),
+	blocks are stored by increasing key.
+*/
+struct BlockRowOrder {
+	static uint64_t	key(size_t blockRow, size_t blockCol, size_t gridCols)
+	{
+		return static_cast<uint64_t>(blockRow) * gridCols + blockCol;
+	}
+};
+
+// Z-order: the bits of blockCol and blockRow interleaved
+struct MortonOrder {
+	static uint64_t	spread(uint64_t x)
+	{
+		x &= 0xffffffffu;
+		x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+		x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+		x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+		x = (x | (x << 2)) & 0x3333333333333333ull;
+		x = (x | (x << 1)) & 0x5555555555555555ull;
+		return x;
+	}
+	static uint64_t	key(size_t blockRow, size_t blockCol, size_t)
+	{
+		return spread(blockCol) | (spread(blockRow) << 1);
+	}
+};
+
+/*
+	B x B blocks, each stored row-major in B * B consecutive doubles, the
+	blocks themselves in the order given by Order. Edge blocks are padded
+	to full size. A tile then touches about (rows / B + 1) * (cols / B + 1)
+	blocks instead of `rows` separate rows, and with B = 32 a block is two
+	4 KiB pages.
+
+	Block starts come from a table built once, so the Morton order needs
+	no power-of-two padding of the block grid.
+*/
+template <size_t B, typename Order>
+class TiledLayout {
+	static_assert(B > 0 && (B & (B - 1)) == 0, "block size must be a power of two");
+
+	private:
+		size_t				gridCols;
+		std::vector<size_t>	blockStart;
+
+	public:
+		static const bool	columnPanels = false;
+		static const size_t	BLOCK = B;
+
+		TiledLayout(size_t rows, size_t cols)
+			: gridCols((cols + B - 1) / B), blockStart(((rows + B - 1) / B) * gridCols)
+		{
+			std::vector<uint64_t> keys(this->blockStart.size());
+			for (size_t k = 0; k < keys.size(); k++)
+				keys[k] = Order::key(k / this->gridCols, k % this->gridCols, this->gridCols);
+			std::vector<size_t> order(keys.size());
+			std::iota(order.begin(), order.end(), size_t(0));
+			std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+			for (size_t rank = 0; rank < order.size(); rank++)
+				this->blockStart[order[rank]] = rank * B * B;
+		}
+
+		size_t	size() const { return this->blockStart.size() * B * B; }
+		size_t	offset(size_t row, size_t col) const
+		{
+			return this->blockStart[(row / B) * this->gridCols + col / B] + (row % B) * B + col % B;
+		}
+
+		template <typename F>
+		void	forEachSpan(size_t startRow, size_t startCol, size_t numRows, size_t numCols, F f) const
+		{
+			size_t endRow = startRow + numRows, endCol = startCol + numCols;
+			for (size_t i = startRow; i < endRow; i = (i / B + 1) * B)
+			{
+				size_t rowsHere = std::min(endRow, (i / B + 1) * B) - i;
+				for (size_t j = startCol; j < endCol; j = (j / B + 1) * B)
+				{
+					size_t colsHere = std::min(endCol, (j / B + 1) * B) - j;
+					size_t first = offset(i, j);
+					// full-width pieces of a block are one run
+					if (colsHere == B)
+						f(first, rowsHere * B);
+					else
+						for (size_t r = 0; r < rowsHere; r++)
+							f(first + r * B, colsHere);
+				}
+			}
+		}
+};
+
+template <size_t B = 32>
+using BlockedLayout = TiledLayout<B, BlockRowOrder>;
+
+template <size_t B = 32>
+using MortonLayout = TiledLayout<B, MortonOrder>;
+
+template <typename Layout>
+class LayoutMatrixView;
+
+/*
+	Dense matrix over one contiguous block in the given layout. Like
+	CompactMatrix, the sum of squares is cached and setValue() keeps it
+	up to date with the delta of the written element.
+*/
+template <typename Layout>
+class LayoutMatrix {
+	private:
+		size_t				rows;
+		size_t				cols;
+		Layout				layout;
+		std::vector<double>	data;
+		mutable double		sum;
+		mutable bool		sumComputed;
+
+	public:
+		LayoutMatrix(size_t rows, size_t cols)
+			: rows(rows), cols(cols), layout(rows, cols), data(layout.size()), sum(0), sumComputed(true)
+		{
+		}
+
+		// bulk conversion, rows are scattered in parallel
+		explicit LayoutMatrix(const Matrix &source)
+			: rows(source.getRows()), cols(source.getCols()), layout(rows, cols), data(layout.size()), sum(0),
+			sumComputed(false)
+		{
+			double **src = source.getRawMatrix();
+			double scale = source.getPendingScale();
+			ThreadPool::instance().parallelFor(0, this->rows, this->cols, [&](size_t lo, size_t hi) {
+				for (size_t i = lo; i < hi; i++)
+					for (size_t j = 0; j < this->cols; j++)
+						this->data[this->layout.offset(i, j)] = scale * src[i][j];
+			});
+		}
+
+		size_t			getRows() const { return this->rows; }
+		size_t			getCols() const { return this->cols; }
+		const Layout	&getLayout() const { return this->layout; }
+		const double	*getData() const { return this->data.data(); }
+
+		// throws std::out_of_range
+		double	getValue(size_t row, size_t col) const
+		{
+			if (row >= this->rows || col >= this->cols)
+				throw std::out_of_range("LayoutMatrix indices are out of range");
+			return this->data[this->layout.offset(row, col)];
+		}
+
+		void	setValue(size_t row, size_t col, double value)
+		{
+			if (row >= this->rows || col >= this->cols)
+				throw std::out_of_range("LayoutMatrix indices are out of range");
+			double &slot = this->data[this->layout.offset(row, col)];
+			if (this->sumComputed)
+				this->sum += value * value - slot * slot;
+			slot = value;
+		}
+
+		Matrix	toMatrix() const { return view(0, 0, this->rows, this->cols).toMatrix(); }
+
+		double	frobeniusNorm() const
+		{
+			if (!this->sumComputed)
+			{
+				// padding is never written, so the whole block can be summed
+				const double *base = this->data.data();
+				this->sum = ThreadPool::instance().parallelReduce(0, this->data.size(), 1, 0.0,
+					[base](size_t lo, size_t hi) { return sumOfSquares(base + lo, hi - lo); },
+					std::plus<double>());
+				this->sumComputed = true;
+			}
+			return std::sqrt(std::max(0.0, this->sum));
+		}
+
+		// throws std::out_of_range if the tile exceeds the matrix
+		LayoutMatrixView<Layout>	view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+		{
+			return LayoutMatrixView<Layout>(*this, startRow, startCol, numRows, numCols);
+		}
+};
+
+/*
+	Rectangular tile of a LayoutMatrix. The norm is cached on first use
+	and, as with MatrixView, not refreshed by later writes to the matrix.
+*/
+template <typename Layout>
+class LayoutMatrixView {
+	private:
+		const LayoutMatrix<Layout>	&matrix;
+		size_t						rows;
+		size_t						cols;
+		size_t						startRow;
+		size_t						startCol;
+		mutable double				sum;
+		mutable bool				sumComputed;
+
+	public:
+		LayoutMatrixView(const LayoutMatrix<Layout> &matrix, size_t startRow, size_t startCol,
+			size_t numRows, size_t numCols)
+			: matrix(matrix), rows(numRows), cols(numCols), startRow(startRow), startCol(startCol), sum(0),
+			sumComputed(false)
+		{
+			if (startRow + numRows > matrix.getRows() || startCol + numCols > matrix.getCols())
+				throw std::out_of_range("LayoutMatrixView exceeds the matrix");
+		}
+
+		const LayoutMatrix<Layout>	&getMatrix() const { return this->matrix; }
+		size_t	getRows() const { return this->rows; }
+		size_t	getCols() const { return this->cols; }
+		size_t	getStartRow() const { return this->startRow; }
+		size_t	getStartCol() const { return this->startCol; }
+
+		double	getValue(size_t row, size_t col) const
+		{
+			if (row >= this->rows || col >= this->cols)
+				throw std::out_of_range("LayoutMatrixView indices are out of range");
+			return this->matrix.getData()[this->matrix.getLayout().offset(this->startRow + row, this->startCol + col)];
+		}
+
+		double	frobeniusNorm() const
+		{
+			if (!this->sumComputed)
+			{
+				const Layout &layout = this->matrix.getLayout();
+				const double *base = this->matrix.getData();
+				size_t panels = Layout::columnPanels ? this->cols : this->rows;
+				size_t cost = Layout::columnPanels ? this->rows : this->cols;
+				this->sum = ThreadPool::instance().parallelReduce(0, panels, cost, 0.0,
+					[&](size_t lo, size_t hi) {
+						double sum = 0;
+						auto add = [&](size_t first, size_t n) { sum += sumOfSquares(base + first, n); };
+						if (Layout::columnPanels)
+							layout.forEachSpan(this->startRow, this->startCol + lo, this->rows, hi - lo, add);
+						else
+							layout.forEachSpan(this->startRow + lo, this->startCol, hi - lo, this->cols, add);
+						return sum;
+					}, std::plus<double>());
+				this->sumComputed = true;
+			}
+			return std::sqrt(this->sum);
+		}
+
+		Matrix	toMatrix() const
+		{
+			Matrix result(this->rows, this->cols);
+			double **dst = result.getRawMatrix();
+			const Layout &layout = this->matrix.getLayout();
+			const double *base = this->matrix.getData();
+			ThreadPool::instance().parallelFor(0, this->rows, this->cols, [&](size_t lo, size_t hi) {
+				for (size_t i = lo; i < hi; i++)
+					for (size_t j = 0; j < this->cols; j++)
+						dst[i][j] = base[layout.offset(this->startRow + i, this->startCol + j)];
+			});
+			result.markWritten(0, this->rows);
+			return result;
+		}
+};
+
+#endif
@@ -4,7 +4,11 @@
 #include <vector>
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
 #include <cstddef> 
+#include <memory>
+#include "ShardedSum.hpp"
 
 # define 	GREEN 		"\e[1;32m"
 # define 	RED 		"\e[1;31m"
@@ -19,51 +23,222 @@
 // class ElementProxy;
 class MatrixView;
 
+/*
+	Heap storage of an owning Matrix: the row blocks and every row pointer
+	table built over them. Tile views share it with their matrix, so the
+	data they look at lives as long as the last of them.
+
+	A zero matrix comes from calloc, i.e. from zero pages the kernel only
+	backs on first write. The first trackedRows rows are tracked in groups
+	of ZERO_BLOCK_ROWS: a group stays "untouched" until something may have
+	written to it, and untouched groups are skipped by norms and copies.
+	Rows past trackedRows always count as written.
+
+	Inside a MatrixArena scope the storage itself, its first block and
+	table come from the arena's pool and are not listed here.
+*/
+struct MatrixStorage {
+	static const size_t ZERO_BLOCK_ROWS = 64;
+
+	std::vector<double *>					blocks;
+	std::vector<double **>					tables;
+	std::unique_ptr<std::atomic<bool>[]>	untouched;
+	size_t									trackedRows;
+
+	MatrixStorage() : trackedRows(0) {}
+	MatrixStorage(const MatrixStorage &other) = delete;
+	MatrixStorage &operator=(const MatrixStorage &other) = delete;
+	~MatrixStorage();
+
+	void	track(size_t rows);
+	void	untrack();
+	bool	isUntouched(size_t row) const;
+	void	markWritten(size_t firstRow, size_t lastRow);
+
+	// calls f(lo, hi) on the maximal row runs of [firstRow, lastRow) that may hold non-zeros
+	template <typename F>
+	void	forEachWritten(size_t firstRow, size_t lastRow, F f) const;
+
+	// sum of squares of a tile, skipping untouched groups
+	double	sumOfSquares(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols) const;
+};
+
+inline bool MatrixStorage::isUntouched(size_t row) const
+{
+	return row < trackedRows && untouched[row / ZERO_BLOCK_ROWS].load(std::memory_order_relaxed);
+}
+
+inline void MatrixStorage::markWritten(size_t firstRow, size_t lastRow)
+{
+	lastRow = std::min(lastRow, trackedRows);
+	if (firstRow >= lastRow)
+		return;
+	for (size_t b = firstRow / ZERO_BLOCK_ROWS; b <= (lastRow - 1) / ZERO_BLOCK_ROWS; b++)
+		if (untouched[b].load(std::memory_order_relaxed))
+			untouched[b].store(false, std::memory_order_relaxed);
+}
+
+template <typename F>
+void MatrixStorage::forEachWritten(size_t firstRow, size_t lastRow, F f) const
+{
+	size_t row = firstRow;
+	while (row < lastRow)
+	{
+		if (isUntouched(row))
+		{
+			row = std::min(lastRow, (row / ZERO_BLOCK_ROWS + 1) * ZERO_BLOCK_ROWS);
+			continue;
+		}
+		size_t end = row;
+		while (end < lastRow && !isUntouched(end))
+			end = end < trackedRows ? std::min(lastRow, (end / ZERO_BLOCK_ROWS + 1) * ZERO_BLOCK_ROWS) : lastRow;
+		f(row, end);
+		row = end;
+	}
+}
+
+/*
+	Matrices of at most INLINE_ELEMENTS elements keep them, and their row
+	table, inside the object: constructing, copying and moving one does
+	not allocate. A small matrix moves to shared heap storage the first
+	time a tile view is taken of it (so the view can outlive it, as with
+	any matrix) or when it grows; row pointers taken from getMatrix()
+	before that keep pointing at the inline copy.
+
+	scale() is lazy where it can be: the factor is kept aside, applied by
+	getValue(), the const operator() and the norm, and multiplied into the
+	elements only when a non-const path needs the rows themselves
+	(getMatrix(), operator(), writes, growth, views). Reads through a
+	const Matrix never write to it: kernels take getRawMatrix() and fold
+	the factor in, so const matrices can be read from several threads.
+*/
 class Matrix {
+	public:
+		static const size_t INLINE_ELEMENTS = 16;
+
 	private:
 		// std::vector<std::vector<double>> matrix;
 		double **matrix;
 		size_t rows;
 		size_t cols;
+		size_t rowCapacity;
 		mutable double sum;
 		mutable bool sumComputed;
+		// logical element = matrix[i][j] * pendingScale
+		double pendingScale;
+		ShardedSum *shards;
+		std::shared_ptr<MatrixStorage> storage;
+		bool ownsData;
+		double *inlineRows[INLINE_ELEMENTS];
+		double inlineData[INLINE_ELEMENTS];
+
+		Matrix();
+		Matrix(double **data, size_t rows, size_t cols);
+		void allocate(size_t rowCapacity, size_t cols, bool zero);
+		void allocateShared(size_t rowCapacity, size_t cols, bool zero);
+		bool isInline() const;
+		void spill();
+		void takeInline(const Matrix &other) noexcept;
+		void release();
+		void growRows(size_t capacity);
+		void ensureRowCapacity(size_t needed);
+		bool canDeferScale() const;
+		double scaleStored(double factor) const;
+		void materialize();
 	public:
 		Matrix(size_t rows, size_t cols);
 		Matrix(size_t rows, size_t cols, double initValue);
 		Matrix(const Matrix &other);
 		Matrix &operator=(const Matrix &other);
-		Matrix(Matrix&& other);
+		Matrix(Matrix&& other) noexcept;
 		
-		Matrix &operator=(Matrix&& other);
+		Matrix &operator=(Matrix&& other) noexcept;
 		~Matrix();
+		void swap(Matrix &other) noexcept;
+
+		// Non-owning matrix over existing row pointers, the caller keeps them alive
+		static Matrix wrap(double **data, size_t rows, size_t cols);
+		// Bulk copy of the numRows x numCols tile at (startRow, startCol);
+		// with the storage of data, its untouched groups are not copied
+		static Matrix fromRows(double **data, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+			const MatrixStorage *written = NULL);
 
 		size_t	getRows() const;
 		size_t	getCols() const;
+		size_t	getRowCapacity() const;
 		double getSum() const;
+		// Rows handed out for writing: every row counts as written from
+		// then on, untouched groups are no longer skipped
+		double **getMatrix();
+		// Rows as stored, for reading: each element is still to be
+		// multiplied by getPendingScale(), 1 unless scale() deferred it
 		double **getMatrix() const;
+		const std::shared_ptr<MatrixStorage> &getStorage() const;
+		// the storage, after moving inline elements to the heap if needed
+		const std::shared_ptr<MatrixStorage> &shareStorage();
+		// true while the row is known to be all zero
+		bool isUntouched(size_t row) const;
 		bool getSumComputed() const;
 		// double get(size_t row, size_t col) const;
 
 	
 		void  setSum(double value) ;
 		void setSumComputed(bool value) ;
+		void addToSum(double delta);
 		void set(size_t row, size_t col, double value);
 		double getValue(size_t row, size_t col) const;
+		// Code writing through getRawMatrix() reports the rows it wrote
+		void markWritten(size_t firstRow, size_t numRows);
 
 	
 		// void  setSum(double value) const;
 		void setValue(size_t row, size_t col, double value);
 
 		MatrixView operator()(size_t row, size_t col);
-		const double &operator()(size_t row, size_t col) const;
+		double operator()(size_t row, size_t col) const;
 		// double &operator()(size_t row, size_t col);
 
 
 		double frobeniusNorm() const;
 
+		// Multiplies every element by factor, the cached sum of squares by
+		// factor^2 in O(1). Applied on the spot, in one pass over the written
+		// rows, while views or other owners share the rows, in
+		// concurrent-write mode, or when the combined pending factor would
+		// leave [2^-256, 2^256] or stop being a finite non-zero number.
+		void scale(double factor);
+		// factor not yet applied to the rows, 1 when none
+		double getPendingScale() const;
+		// the rows as stored, each element still to be multiplied by
+		// getPendingScale(); for kernels that fold the factor in, and for
+		// writers that keep the zero tracking with markWritten()
+		double **getRawMatrix() const;
+
+		// Growth: rows on the heap never move, views created before keep
+		// seeing the rows they were created over
+		void reserveRows(size_t capacity);
+		void appendRow(const double *values);
+		void appendRow(const std::vector<double> &values);
+		void appendRows(const MatrixView &block);
+		void appendRows(const Matrix &block);
+		void resize(size_t rows, size_t cols);
+		// same element count, new shape, data left in place
+		void reshape(size_t rows, size_t cols);
+
+		// Concurrent-write mode: element writes through operator() accumulate
+		// their sum-of-squares delta in per-thread shards (0 = one per core)
+		void enableConcurrentWrites(size_t shardCount = 0);
+		void disableConcurrentWrites();
+		bool isConcurrentWrites() const;
+
 		friend std::ostream& operator<<(std::ostream &os, const Matrix &matrix);
 };
 
+inline void swap(Matrix &a, Matrix &b) noexcept
+{
+	a.swap(b);
+}
+
 #include "MatrixView.hpp"
 
 #endif
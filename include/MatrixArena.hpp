@@ -0,0 +1,116 @@
+#ifndef MATRIXARENA_HPP
+#define MATRIXARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*
+	Bump allocator behind a MatrixArena: memory comes in chunks and is
+	only released, all at once, when the pool is destroyed. Chunks of the
+	default size go back to a small process-wide cache rather than to the
+	system, so the next scope reuses memory that is already mapped and
+	likely still in cache.
+	Not thread safe, only the thread that opened the scope allocates.
+
+	The pool is reference counted by hand: the scope holds one reference
+	and every ArenaAllocator allocation another, so that the last storage
+	to die, on whatever thread, frees it.
+*/
+class ArenaPool {
+	private:
+		size_t				chunkBytes;
+		std::vector<char *>	chunks;
+		std::vector<size_t>	sizes;
+		char				*next;
+		size_t				left;
+		size_t				used;
+		std::atomic<size_t>	references;
+
+		~ArenaPool();
+
+	public:
+		// the caller holds the first reference
+		explicit ArenaPool(size_t chunkBytes);
+		ArenaPool(const ArenaPool &other) = delete;
+		ArenaPool &operator=(const ArenaPool &other) = delete;
+
+		void	retain();
+		// deletes the pool with the last reference
+		void	release();
+
+		// 64-byte aligned, zero-filled on request
+		void	*allocate(size_t bytes, bool zero = false);
+		size_t	getUsed() const;
+		size_t	getChunks() const;
+};
+
+/*
+	Scoped allocation context for Matrix storage.
+
+		{
+			MatrixArena scope;
+			Matrix tmp = view;		// bump-allocated
+			...
+		}							// one release for everything
+
+	While a scope is open on a thread, every Matrix storage allocated on
+	that thread (element block, row table and the shared storage header)
+	comes from its pool. Scopes nest, the innermost one wins. Threads of
+	the pool allocate on the heap as usual.
+
+	A matrix or view that outlives the scope keeps the pool alive through
+	its storage, so escaping is safe; the memory is then released with the
+	last of them. Rows added by growth go to the heap.
+*/
+class MatrixArena {
+	private:
+		ArenaPool	*pool;
+		MatrixArena	*previous;
+
+	public:
+		explicit MatrixArena(size_t chunkBytes = size_t(1) << 20);
+		MatrixArena(const MatrixArena &other) = delete;
+		MatrixArena &operator=(const MatrixArena &other) = delete;
+		~MatrixArena();
+
+		// innermost open scope of the calling thread, NULL if none
+		static MatrixArena	*current();
+
+		ArenaPool	*getPool() const;
+		void	*allocate(size_t bytes, bool zero = false);
+		// bytes handed out so far
+		size_t	getUsed() const;
+};
+
+/*
+	std allocator over an ArenaPool, for allocate_shared. Copies are free;
+	each allocation holds a pool reference until it is deallocated, which
+	for a shared_ptr control block is the last thing done with it.
+*/
+template <typename T>
+class ArenaAllocator {
+	public:
+		typedef T value_type;
+
+		ArenaPool	*pool;
+
+		explicit ArenaAllocator(ArenaPool *pool) : pool(pool) {}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) : pool(other.pool) {}
+
+		T		*allocate(size_t n)
+		{
+			T *p = static_cast<T *>(pool->allocate(n * sizeof(T)));
+			pool->retain();
+			return p;
+		}
+		void	deallocate(T *, size_t) { pool->release(); }
+
+		template <typename U>
+		bool	operator==(const ArenaAllocator<U> &other) const { return pool == other.pool; }
+		template <typename U>
+		bool	operator!=(const ArenaAllocator<U> &other) const { return pool != other.pool; }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef MATRIXBATCH_HPP
+#define MATRIXBATCH_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Matrix.hpp"
+
+class MatrixBatch;
+
+/*
+	One matrix of a MatrixBatch, read and written in place.
+	Valid as long as the batch is.
+*/
+class BatchMember {
+	private:
+		MatrixBatch	*batch;
+		size_t		index;
+
+	public:
+		BatchMember(MatrixBatch &batch, size_t index);
+
+		size_t	getIndex() const;
+		size_t	getRows() const;
+		size_t	getCols() const;
+
+		double			&operator()(size_t row, size_t col);
+		const double	&operator()(size_t row, size_t col) const;
+		// throws std::out_of_range
+		double	getValue(size_t row, size_t col) const;
+		void	setValue(size_t row, size_t col, double value);
+
+		double	frobeniusNorm() const;
+		Matrix	toMatrix() const;
+		// throws std::invalid_argument if the shapes differ
+		void	assign(const Matrix &source);
+};
+
+/*
+	`count` matrices of the same rows x cols shape in one buffer,
+	interleaved across the batch in groups of LANES matrices: element
+	(r, c) of the LANES matrices of a group is LANES consecutive doubles,
+	and a group is rows * cols * LANES doubles. The batched kernels then
+	work on whole vectors of one element across LANES matrices, with no
+	horizontal reductions and no per-matrix call.
+
+	The last group is padded with zero matrices, which every operation
+	keeps at zero.
+*/
+class MatrixBatch {
+	public:
+		static const size_t LANES = 8;
+
+	private:
+		size_t				count;
+		size_t				rows;
+		size_t				cols;
+		std::vector<double>	data;
+
+	public:
+		MatrixBatch(size_t count, size_t rows, size_t cols, double initValue = 0.0);
+
+		size_t	getCount() const;
+		size_t	getRows() const;
+		size_t	getCols() const;
+		size_t	getGroups() const;
+
+		// distance between consecutive elements of one matrix is LANES
+		double			*elementPtr(size_t index, size_t row, size_t col);
+		const double	*elementPtr(size_t index, size_t row, size_t col) const;
+
+		// throws std::out_of_range
+		BatchMember		member(size_t index);
+
+		// norms[k] = ||matrix k||_F, computed group by group in parallel
+		std::vector<double>	frobeniusNorms() const;
+		void				frobeniusNorms(double *norms) const;
+
+		// element-wise, across the whole batch
+		void	fill(double value);
+		void	scale(double alpha);
+		// this += alpha * other; throws std::invalid_argument if the batches differ in shape
+		void	axpy(double alpha, const MatrixBatch &other);
+		void	add(const MatrixBatch &other);
+		void	hadamard(const MatrixBatch &other);
+};
+
+#endif
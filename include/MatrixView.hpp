@@ -5,11 +5,13 @@
 #include <cmath>
 #include <stdexcept>
 #include <cstddef> 
+#include <memory>
 
 
 
 class Matrix;
 class MatrixViewHelper;
+struct MatrixStorage;
 
 class MatrixView {
 	public:
@@ -23,6 +25,8 @@ class MatrixView {
         mutable bool sumComputed;
         size_t row;
         size_t col;
+        // tile views keep the parent's rows alive
+        std::shared_ptr<MatrixStorage> storage;
 
         
 
@@ -61,6 +65,12 @@ class MatrixView {
 
 
         double frobeniusNorm() const; 
+        // Multiplies the tile in place, the view's and the parent's sums
+        // follow without a rescan. Unlike Matrix::scale this is not lazy: the
+        // rows are shared with the parent and every other view of it, which
+        // all read them directly, so a factor kept on one view would be
+        // missed by the others and by every kernel reading matrix_ptr.
+        void scale(double factor);
 		// MatrixView subMatrix(size_t rows, size_t cols, size_t startRow, size_t startCol) const;
 };
 #include "Matrix.hpp"
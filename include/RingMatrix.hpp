@@ -0,0 +1,68 @@
+#ifndef RINGMATRIX_HPP
+#define RINGMATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+#include "ConstMatrixView.hpp"
+#include "Matrix.hpp"
+
+/*
+	Sliding window over the last `capacity` rows of a stream.
+
+	push() overwrites the oldest row in place once the buffer is full.
+	Rows are addressed in logical order, 0 being the oldest.
+
+	Each stored row carries the running sum of squares of every row pushed
+	up to it, so the norm of the newest `length` rows is one subtraction:
+	push() is O(cols) and windowNorm() is O(1). The running sums are
+	rebased every `capacity` pushes to keep them of the order of the
+	window.
+
+	The row pointer table lists every physical row twice, so any run of
+	logical rows is contiguous in it and view() can hand out a tile of it
+	directly. Views are a ConstMatrixView, read-only so the rows behind
+	the running sums cannot change, and valid until the next push.
+*/
+class RingMatrix {
+	private:
+		size_t					capacity;
+		size_t					cols;
+		size_t					head;		// physical index of the oldest row
+		size_t					count;
+		size_t					sinceRebase;
+		Matrix					data;
+		std::vector<double *>	table;
+		Matrix					window;
+		std::vector<double>		cumulative;
+		double					evicted;	// running sum just before the oldest row
+
+		size_t	physical(size_t row) const;
+		void	rebase();
+
+	public:
+		RingMatrix(size_t capacity, size_t cols);
+		RingMatrix(const RingMatrix &other) = delete;
+		RingMatrix &operator=(const RingMatrix &other) = delete;
+
+		size_t	getCapacity() const;
+		size_t	getRows() const;
+		size_t	getCols() const;
+		bool	isFull() const;
+
+		void	push(const double *row);
+		void	push(const std::vector<double> &row);
+		void	clear();
+
+		double			getValue(size_t row, size_t col) const;
+		const double	*getRow(size_t row) const;
+
+		ConstMatrixView	view() const;
+		ConstMatrixView	view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const;
+
+		// every stored row
+		double	frobeniusNorm() const;
+		// the newest `length` rows
+		double	windowNorm(size_t length) const;
+};
+
+#endif
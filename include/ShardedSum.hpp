@@ -0,0 +1,37 @@
+#ifndef SHARDEDSUM_HPP
+#define SHARDEDSUM_HPP
+
+#include <atomic>
+#include <cstddef>
+
+/*
+	Sum of squares split across cache-line padded shards.
+
+	Thread slot i < shardCount owns shard i and updates it with a plain
+	relaxed load/store (no locked instruction). Threads with a higher slot
+	share one overflow shard that is updated with a CAS loop.
+	total() combines the partials, it is exact once the writers are joined.
+*/
+class ShardedSum {
+	private:
+		struct alignas(64) Shard {
+			std::atomic<double> value;
+		};
+
+		Shard	*shards;
+		size_t	shardCount;
+
+	public:
+		explicit ShardedSum(size_t shardCount);
+		ShardedSum(const ShardedSum &other) = delete;
+		ShardedSum &operator=(const ShardedSum &other) = delete;
+		~ShardedSum();
+
+		size_t	getShardCount() const;
+
+		void	add(double delta);
+		double	total() const;
+		void	reset();
+};
+
+#endif
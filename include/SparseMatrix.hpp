@@ -0,0 +1,116 @@
+#ifndef SPARSEMATRIX_HPP
+#define SPARSEMATRIX_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Matrix.hpp"
+
+class SparseMatrixView;
+
+/*
+	Compressed sparse matrix, row-major (CSR) or column-major (CSC).
+
+	offsets has one entry per major line plus one: the non-zeros of line k
+	are indices/values[offsets[k] .. offsets[k + 1]), with their minor
+	indices strictly increasing. Rows are the major lines in CSR, columns
+	in CSC.
+
+	The structure is immutable once built, so the sum of squares is
+	computed at construction and frobeniusNorm() is O(1).
+*/
+class SparseMatrix {
+	public:
+		enum Format { CSR, CSC };
+
+	private:
+		size_t				rows;
+		size_t				cols;
+		Format				format;
+		std::vector<size_t>	offsets;
+		std::vector<size_t>	indices;
+		std::vector<double>	values;
+		double				sum;
+
+		void	validate() const;
+		void	computeSum();
+
+	public:
+		SparseMatrix(size_t rows, size_t cols, Format format = CSR);
+		// takes the compressed arrays as they are; throws std::invalid_argument if inconsistent
+		SparseMatrix(size_t rows, size_t cols, Format format, std::vector<size_t> offsets,
+			std::vector<size_t> indices, std::vector<double> values);
+		// keeps the entries with |value| > dropTolerance
+		explicit SparseMatrix(const Matrix &dense, Format format = CSR, double dropTolerance = 0.0);
+
+		size_t	getRows() const;
+		size_t	getCols() const;
+		Format	getFormat() const;
+		size_t	getNonZeros() const;
+		size_t	getMajorSize() const;
+		const std::vector<size_t>	&getOffsets() const;
+		const std::vector<size_t>	&getIndices() const;
+		const std::vector<double>	&getValues() const;
+
+		// binary search in the major line, 0 for an absent entry
+		double	getValue(size_t row, size_t col) const;
+
+		SparseMatrix	convert(Format format) const;
+		Matrix			toDense() const;
+
+		double				frobeniusNorm() const;
+		SparseMatrixView	view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const;
+};
+
+/*
+	Rectangular tile of a SparseMatrix.
+
+	frobeniusNorm() binary-searches the first and last minor index of the
+	tile in every major line it crosses and squares only the non-zeros in
+	between: O(majors * log(nnz per line) + nnz in tile) instead of the
+	O(rows * cols) dense scan. The result is cached like MatrixView's.
+*/
+class SparseMatrixView {
+	private:
+		const SparseMatrix	&matrix;
+		size_t				rows;
+		size_t				cols;
+		size_t				startRow;
+		size_t				startCol;
+		mutable double		sum;
+		mutable bool		sumComputed;
+
+	public:
+		// throws std::out_of_range if the tile exceeds the matrix
+		SparseMatrixView(const SparseMatrix &matrix, size_t startRow, size_t startCol, size_t numRows, size_t numCols);
+
+		const SparseMatrix	&getMatrix() const;
+		size_t	getRows() const;
+		size_t	getCols() const;
+		size_t	getStartRow() const;
+		size_t	getStartCol() const;
+
+		// [first, last) positions in indices/values of major line k inside the tile
+		void	lineRange(size_t k, size_t &first, size_t &last) const;
+
+		double	getValue(size_t row, size_t col) const;
+		size_t	getNonZeros() const;
+		double	frobeniusNorm() const;
+		Matrix	toDense() const;
+};
+
+/*
+	Sparse matrix-vector product, y = alpha * A * x + beta * y.
+
+	CSR tiles compute one dot product per row in parallel. CSC tiles are
+	split into row ranges, each scattering every column's entries that
+	fall into its range, so no two threads write the same y entries.
+	With beta == 0, y is not read. The vector overloads check the sizes
+	(std::invalid_argument) and resize y when beta == 0.
+*/
+void	spmv(const SparseMatrixView &a, const double *x, double *y, double alpha = 1.0, double beta = 0.0);
+void	spmv(const SparseMatrixView &a, const std::vector<double> &x, std::vector<double> &y,
+			double alpha = 1.0, double beta = 0.0);
+void	spmv(const SparseMatrix &a, const std::vector<double> &x, std::vector<double> &y,
+			double alpha = 1.0, double beta = 0.0);
+
+#endif
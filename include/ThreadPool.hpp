@@ -0,0 +1,193 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+	Work-stealing pool shared by every parallel Matrix operation.
+
+	Each worker owns a deque: it pops its own newest task and steals the
+	oldest task of the others when it runs dry. Tasks submitted from
+	outside the pool go to a shared injection queue. Idle workers spin for
+	spinIterations rounds before parking on a condition variable.
+
+	instance() is configured from the environment on first use:
+		MATRIX_THREADS			worker count (default: hardware threads)
+		MATRIX_PIN_THREADS		1 to pin worker i to core i (Linux only)
+		MATRIX_SPIN				spin rounds before parking
+		MATRIX_SERIAL_CUTOFF	work size (elements) below which
+								parallelFor runs on the caller
+*/
+class ThreadPool {
+	public:
+		struct Config {
+			size_t	threads;
+			bool	pinThreads;
+			size_t	spinIterations;
+			size_t	serialCutoff;
+
+			Config();
+			static Config	fromEnvironment();
+		};
+
+	private:
+		struct Worker {
+			std::deque<std::function<void()>>	tasks;
+			std::mutex							mutex;
+		};
+
+		Config								config;
+		std::vector<std::thread>			threads;
+		std::vector<Worker *>				workers;
+		std::deque<std::function<void()>>	injected;
+		std::mutex							mutex;
+		std::condition_variable				taskReady;
+		std::condition_variable				allDone;
+		std::atomic<size_t>					pending;
+		std::atomic<size_t>					queued;
+		std::atomic<size_t>					sleeping;
+		bool								stopping;
+		std::exception_ptr					error;		// first exception of a submitted task
+
+		void	start();
+		void	stop();
+		void	workerLoop(size_t index);
+		bool	tryRunOne(size_t index);
+		void	runTask(std::function<void()> &task);
+		void	waitIdle();
+
+	public:
+		explicit ThreadPool(size_t threadCount);
+		explicit ThreadPool(const Config &config);
+		ThreadPool(const ThreadPool &other) = delete;
+		ThreadPool &operator=(const ThreadPool &other) = delete;
+		~ThreadPool();
+
+		static ThreadPool	&instance();
+
+		size_t	getThreadCount() const;
+		const Config	&getConfig() const;
+		void	configure(const Config &config);
+
+		// A task that throws does not stop the pool: the first exception
+		// since the last wait() is kept and rethrown by wait(), later ones
+		// are dropped.
+		void	submit(std::function<void()> task);
+		void	wait();
+
+		bool	isWorkerThread() const;
+		bool	runsSerially(size_t work) const;
+
+		/*
+			Calls f(lo, hi) on disjoint chunks covering [begin, end).
+			costPerItem is the number of elements behind one index; the
+			loop stays on the calling thread when the total is below the
+			serial cutoff. The caller runs chunks too and returns when all
+			of them are done, so nested calls cannot deadlock.
+			If f throws, the chunks not started yet are skipped, the ones
+			in flight are waited for and the first exception is rethrown
+			on the caller.
+		*/
+		template <typename F>
+		void	parallelFor(size_t begin, size_t end, size_t costPerItem, F f);
+
+		/*
+			Combines f(lo, hi) over the same chunks as parallelFor, in chunk
+			order, so the result does not depend on scheduling.
+		*/
+		template <typename T, typename F, typename Combine>
+		T		parallelReduce(size_t begin, size_t end, size_t costPerItem, T identity, F f, Combine combine);
+};
+
+template <typename F>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t costPerItem, F f)
+{
+	if (end <= begin)
+		return;
+	size_t items = end - begin;
+	if (runsSerially(items * costPerItem) || items == 1)
+	{
+		f(begin, end);
+		return;
+	}
+
+	size_t chunks = std::min(items, getThreadCount() * 4);
+	size_t chunkSize = (items + chunks - 1) / chunks;
+	chunks = (items + chunkSize - 1) / chunkSize;
+
+	struct Group {
+		std::atomic<size_t>	next;
+		std::atomic<size_t>	done;
+		std::atomic<bool>	failed;
+		std::mutex			mutex;
+		std::exception_ptr	error;
+	};
+	std::shared_ptr<Group> group = std::make_shared<Group>();
+	group->next.store(0);
+	group->done.store(0);
+	group->failed.store(false);
+
+	// chunks claimed after a failure are counted as done without running f
+	std::function<void()> drain = [group, begin, end, chunks, chunkSize, &f]() {
+		for (size_t c = group->next.fetch_add(1); c < chunks; c = group->next.fetch_add(1))
+		{
+			if (!group->failed.load(std::memory_order_relaxed))
+			{
+				size_t lo = begin + c * chunkSize;
+				try {
+					f(lo, std::min(end, lo + chunkSize));
+				} catch (...) {
+					std::lock_guard<std::mutex> lock(group->mutex);
+					if (!group->error)
+						group->error = std::current_exception();
+					group->failed.store(true, std::memory_order_relaxed);
+				}
+			}
+			group->done.fetch_add(1, std::memory_order_release);
+		}
+	};
+	size_t helpers = std::min(chunks, getThreadCount()) - 1;
+	for (size_t i = 0; i < helpers; i++)
+		submit(drain);
+	drain();
+	while (group->done.load(std::memory_order_acquire) < chunks)
+		std::this_thread::yield();
+	if (group->error)
+		std::rethrow_exception(group->error);
+}
+
+template <typename T, typename F, typename Combine>
+T ThreadPool::parallelReduce(size_t begin, size_t end, size_t costPerItem, T identity, F f, Combine combine)
+{
+	if (end <= begin)
+		return identity;
+	size_t items = end - begin;
+	if (runsSerially(items * costPerItem) || items == 1)
+		return combine(identity, f(begin, end));
+
+	size_t chunks = std::min(items, getThreadCount() * 4);
+	size_t chunkSize = (items + chunks - 1) / chunks;
+	chunks = (items + chunkSize - 1) / chunkSize;
+
+	std::vector<T> partial(chunks, identity);
+	parallelFor(0, chunks, chunkSize * costPerItem, [&](size_t lo, size_t hi) {
+		for (size_t c = lo; c < hi; c++)
+			partial[c] = f(begin + c * chunkSize, std::min(end, begin + (c + 1) * chunkSize));
+	});
+	T result = identity;
+	for (size_t c = 0; c < chunks; c++)
+		result = combine(result, partial[c]);
+	return result;
+}
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef THREADSLOT_HPP
+#define THREADSLOT_HPP
+
+#include <cstddef>
+
+/*
+	Dense, recycled index of the calling thread.
+
+	The first call on a thread claims the lowest free slot, the slot is
+	given back when the thread exits. Live threads never share a slot, so
+	per-thread arrays can be indexed without synchronisation.
+*/
+size_t	threadSlot();
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef TILEPIPELINE_HPP
+#define TILEPIPELINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Matrix.hpp"
+#include "ThreadPool.hpp"
+
+/*
+	Overlaps filling a Matrix with tile-norm queries on it.
+
+	The producer fills rows in order and calls publishRows(n) once rows
+	[0, n) are final. Each submitted tile waits until the watermark covers
+	its last row and then runs on the thread pool, while the producer keeps
+	filling the rows below.
+	Tiles only read rows under the watermark, the producer only writes rows
+	above it, so they never touch the same data.
+*/
+class TilePipeline {
+	private:
+		struct Tile {
+			size_t	startRow;
+			size_t	startCol;
+			size_t	numRows;
+			size_t	numCols;
+			std::shared_ptr<std::promise<double>>	result;
+		};
+
+		Matrix							&matrix;
+		ThreadPool						&pool;
+		std::atomic<size_t>				rowsReady;
+		std::multimap<size_t, Tile>		waiting;
+		std::vector<std::shared_future<double>>	futures;
+		std::mutex						mutex;
+		std::condition_variable			rowsPublished;
+
+		void	dispatch(const Tile &tile);
+
+	public:
+		TilePipeline(Matrix &matrix, ThreadPool &pool = ThreadPool::instance());
+		TilePipeline(const TilePipeline &other) = delete;
+		TilePipeline &operator=(const TilePipeline &other) = delete;
+		~TilePipeline();
+
+		size_t	getRowsReady() const;
+
+		// producer side
+		void	publishRows(size_t rowsReady);
+		void	finish();
+
+		// consumer side
+		size_t	submit(size_t startRow, size_t startCol, size_t numRows, size_t numCols);
+		void	waitForRows(size_t rows);
+		double	result(size_t id);
+		std::vector<double>	results();
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef VERSIONEDMATRIX_HPP
+#define VERSIONEDMATRIX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ConstMatrixView.hpp"
+#include "Matrix.hpp"
+
+/*
+	Single-writer / multi-reader matrix with snapshot isolation.
+
+	Data is stored in blocks of blockRows rows. The writer edits a private
+	working copy, copying a block the first time it is modified after a
+	publish (copy-on-write at block granularity), and publish() makes the
+	pending edits visible atomically as a new version.
+
+	Readers pin a version with snapshot(): pinning only announces the
+	reader's epoch in a free slot and never waits for the writer.
+	At most maxReaders snapshots are held at once; snapshot() beyond that
+	waits, yielding and then sleeping, until another snapshot is released.
+	Versions are reclaimed by the writer once no pinned epoch can still see
+	them (epoch-based reclamation).
+*/
+class VersionedMatrix {
+	private:
+		struct Version {
+			uint64_t							epoch;
+			std::vector<std::shared_ptr<double[]>>	blocks;
+			std::vector<double *>				rowPtrs;
+			Matrix								matrix;
+
+			Version(uint64_t epoch, const std::vector<std::shared_ptr<double[]>> &blocks,
+				std::vector<double *> &&rowPtrs, size_t cols, double sum);
+		};
+
+		struct alignas(64) ReaderSlot {
+			std::atomic<uint64_t> epoch;
+		};
+
+		static const uint64_t FREE_SLOT = UINT64_MAX;
+
+		size_t		rows;
+		size_t		cols;
+		size_t		blockRows;
+
+		// writer side
+		std::vector<std::shared_ptr<double[]>>	workBlocks;
+		std::vector<bool>						workOwned;
+		double									workSum;
+		std::vector<std::pair<Version *, uint64_t>>	retired;
+
+		// shared with readers
+		std::atomic<Version *>	current;
+		std::atomic<uint64_t>	globalEpoch;
+		ReaderSlot				*slots;
+		size_t					slotCount;
+
+		void	init();
+		double	*writableRow(size_t row);
+		size_t	pin() const;
+		void	unpin(size_t slot) const;
+		uint64_t	oldestPinnedEpoch() const;
+
+	public:
+		class Snapshot {
+			private:
+				const VersionedMatrix	*owner;
+				size_t					slot;
+				const Version			*version;
+
+				friend class VersionedMatrix;
+				Snapshot(const VersionedMatrix *owner, size_t slot, const Version *version);
+
+			public:
+				Snapshot(const Snapshot &other) = delete;
+				Snapshot &operator=(const Snapshot &other) = delete;
+				Snapshot(Snapshot &&other);
+				Snapshot &operator=(Snapshot &&other);
+				~Snapshot();
+
+				uint64_t		getEpoch() const;
+				const Matrix	&matrix() const;
+				// read-only: the blocks behind it are shared with other versions
+				ConstMatrixView	view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const;
+				double			frobeniusNorm() const;
+		};
+
+		VersionedMatrix(size_t rows, size_t cols, size_t blockRows = 64, size_t maxReaders = 256);
+		VersionedMatrix(const Matrix &initial, size_t blockRows = 64, size_t maxReaders = 256);
+		VersionedMatrix(const VersionedMatrix &other) = delete;
+		VersionedMatrix &operator=(const VersionedMatrix &other) = delete;
+		~VersionedMatrix();
+
+		size_t	getRows() const;
+		size_t	getCols() const;
+		size_t	getBlockRows() const;
+		size_t	getRetiredCount() const;
+
+		// writer API (one writer thread)
+		double	getValue(size_t row, size_t col) const;
+		void	setValue(size_t row, size_t col, double value);
+		void	publish();
+		void	reclaim();
+
+		// reader API (any thread)
+		Snapshot	snapshot() const;
+};
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef APPLY_HPP
+#define APPLY_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "ThreadPool.hpp"
+
+/*
+	Element-wise map over a Matrix or MatrixView.
+
+	apply(policy, view, f)			view(i, j) = f(view(i, j))
+	transform(policy, src, dst, f)	dst(i, j) = f(src(i, j))
+
+	f is a double -> double callable. Each row is walked as one contiguous
+	span, bypassing operator() and its proxy. The old and new sums of
+	squares of the written tile are accumulated in the same pass, so the
+	cached sum of the view is exact afterwards and the parent matrix gets
+	the delta through addToSum(). On a whole Matrix both become exact.
+
+	Policies mirror std::execution:
+		policy::seq			one thread, in row order
+		policy::par			rows split over the shared thread pool
+		policy::par_unseq	par, and f may be vectorised across a row;
+							f must not depend on the order of calls
+	The overloads without a policy use policy::par.
+*/
+
+namespace policy {
+
+struct Sequenced {};
+struct Parallel {};
+struct ParallelUnsequenced {};
+
+constexpr Sequenced				seq = Sequenced();
+constexpr Parallel				par = Parallel();
+constexpr ParallelUnsequenced	par_unseq = ParallelUnsequenced();
+
+}
+
+namespace apply_detail {
+
+// old and new sum of squares of the rows written so far
+typedef std::pair<double, double> SumDelta;
+
+inline SumDelta addDeltas(SumDelta a, SumDelta b)
+{
+	return SumDelta(a.first + b.first, a.second + b.second);
+}
+
+template <typename F>
+SumDelta mapSpan(const double *src, double *dst, size_t n, F &f, policy::Sequenced)
+{
+	double before = 0, after = 0;
+	for (size_t j = 0; j < n; j++)
+	{
+		double old = dst[j];
+		double value = f(src[j]);
+		dst[j] = value;
+		before += old * old;
+		after += value * value;
+	}
+	return SumDelta(before, after);
+}
+
+template <typename F>
+SumDelta mapSpan(const double *src, double *dst, size_t n, F &f, policy::Parallel)
+{
+	return mapSpan(src, dst, n, f, policy::seq);
+}
+
+/*
+	src and dst are either the same span or disjoint (checked by the
+	callers), so there is no loop-carried dependency to respect. Four
+	accumulators let the reductions vectorise.
+*/
+template <typename F>
+SumDelta mapSpan(const double *src, double *dst, size_t n, F &f, policy::ParallelUnsequenced)
+{
+	double b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+	double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+	size_t j = 0;
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+	for (; j + 4 <= n; j += 4)
+	{
+		double o0 = dst[j], o1 = dst[j + 1], o2 = dst[j + 2], o3 = dst[j + 3];
+		double v0 = f(src[j]), v1 = f(src[j + 1]), v2 = f(src[j + 2]), v3 = f(src[j + 3]);
+		dst[j] = v0;
+		dst[j + 1] = v1;
+		dst[j + 2] = v2;
+		dst[j + 3] = v3;
+		b0 += o0 * o0;
+		b1 += o1 * o1;
+		b2 += o2 * o2;
+		b3 += o3 * o3;
+		a0 += v0 * v0;
+		a1 += v1 * v1;
+		a2 += v2 * v2;
+		a3 += v3 * v3;
+	}
+	for (; j < n; j++)
+	{
+		double old = dst[j];
+		double value = f(src[j]);
+		dst[j] = value;
+		b0 += old * old;
+		a0 += value * value;
+	}
+	return SumDelta((b0 + b1) + (b2 + b3), (a0 + a1) + (a2 + a3));
+}
+
+template <typename F, typename Policy>
+SumDelta mapRows(double **src, size_t srcCol, double **dst, size_t dstCol,
+	size_t lo, size_t hi, size_t cols, F &f, Policy p)
+{
+	SumDelta total(0, 0);
+	for (size_t i = lo; i < hi; i++)
+		total = addDeltas(total, mapSpan(src[i] + srcCol, dst[i] + dstCol, cols, f, p));
+	return total;
+}
+
+template <typename F, typename Policy>
+SumDelta mapTile(double **src, size_t srcCol, double **dst, size_t dstCol,
+	size_t rows, size_t cols, F &f, Policy p)
+{
+	return ThreadPool::instance().parallelReduce(0, rows, cols, SumDelta(0, 0),
+		[&](size_t lo, size_t hi) { return mapRows(src, srcCol, dst, dstCol, lo, hi, cols, f, p); },
+		addDeltas);
+}
+
+template <typename F>
+SumDelta mapTile(double **src, size_t srcCol, double **dst, size_t dstCol,
+	size_t rows, size_t cols, F &f, policy::Sequenced p)
+{
+	return mapRows(src, srcCol, dst, dstCol, 0, rows, cols, f, p);
+}
+
+// the view cache becomes exact, the parent sum moves by the delta
+inline void commit(MatrixView &view, SumDelta delta)
+{
+	view.sum = delta.second;
+	view.sumComputed = true;
+	if (view.storage)
+		view.storage->markWritten(view.startRow, view.startRow + view.rows);
+	view.matrix.addToSum(delta.second - delta.first);
+}
+
+// true when the tiles share at least one element
+inline bool overlaps(const MatrixView &a, const MatrixView &b)
+{
+	if (a.matrix_ptr != b.matrix_ptr)
+		return false;
+	return a.startRow < b.startRow + b.rows && b.startRow < a.startRow + a.rows
+		&& a.startCol < b.startCol + b.cols && b.startCol < a.startCol + a.cols;
+}
+
+}
+
+template <typename Policy, typename F>
+void apply(Policy p, MatrixView &view, F f)
+{
+	double **rows = view.matrix_ptr + view.startRow;
+	apply_detail::SumDelta delta = apply_detail::mapTile(rows, view.startCol, rows, view.startCol,
+		view.rows, view.cols, f, p);
+	apply_detail::commit(view, delta);
+}
+
+template <typename Policy, typename F>
+void apply(Policy p, Matrix &m, F f)
+{
+	MatrixView view(m, 0, 0, m.getRows(), m.getCols());
+	apply(p, view, f);
+	m.setSum(view.sum);
+	m.setSumComputed(true);
+}
+
+template <typename F>
+void apply(MatrixView &view, F f)
+{
+	apply(policy::par, view, f);
+}
+
+template <typename F>
+void apply(Matrix &m, F f)
+{
+	apply(policy::par, m, f);
+}
+
+/*
+	dst may be the same tile as src (then this is apply); any other
+	overlap throws std::invalid_argument, as do mismatched dimensions.
+*/
+template <typename Policy, typename F>
+void transform(Policy p, const MatrixView &src, MatrixView &dst, F f)
+{
+	if (src.rows != dst.rows || src.cols != dst.cols)
+		throw std::invalid_argument("transform dimensions do not match");
+	bool same = src.matrix_ptr == dst.matrix_ptr && src.startRow == dst.startRow && src.startCol == dst.startCol;
+	if (!same && apply_detail::overlaps(src, dst))
+		throw std::invalid_argument("transform source and destination overlap");
+
+	apply_detail::SumDelta delta = apply_detail::mapTile(src.matrix_ptr + src.startRow, src.startCol,
+		dst.matrix_ptr + dst.startRow, dst.startCol, dst.rows, dst.cols, f, p);
+	apply_detail::commit(dst, delta);
+}
+
+/*
+	src is read as stored, f sees each element with the pending scale of
+	src applied, so a const source is never written. dst is taken first:
+	when it is src itself its factor is then already in the rows.
+*/
+template <typename Policy, typename F>
+void transform(Policy p, const Matrix &src, Matrix &dst, F f)
+{
+	if (src.getRows() != dst.getRows() || src.getCols() != dst.getCols())
+		throw std::invalid_argument("transform dimensions do not match");
+	MatrixView d(dst, 0, 0, dst.getRows(), dst.getCols());
+	double scale = src.getPendingScale();
+	auto scaled = [&f, scale](double x) { return f(scale * x); };
+	apply_detail::SumDelta delta = apply_detail::mapTile(src.getRawMatrix(), 0, d.matrix_ptr, 0,
+		d.rows, d.cols, scaled, p);
+	apply_detail::commit(d, delta);
+	dst.setSum(d.sum);
+	dst.setSumComputed(true);
+}
+
+template <typename F>
+void transform(const MatrixView &src, MatrixView &dst, F f)
+{
+	transform(policy::par, src, dst, f);
+}
+
+template <typename F>
+void transform(const Matrix &src, Matrix &dst, F f)
+{
+	transform(policy::par, src, dst, f);
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef AXISREDUCTIONS_HPP
+#define AXISREDUCTIONS_HPP
+
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	Per-row and per-column reductions.
+
+	out is resized to getRows() (row variants) or getCols() (column
+	variants). Row variants reduce each contiguous row span; column
+	variants walk the rows in memory order and accumulate into a vector of
+	column partials instead of striding down the columns. Both split the
+	rows across the shared thread pool.
+*/
+
+void	rowSums(const MatrixView& view, std::vector<double>& out);
+void	rowNorms(const MatrixView& view, std::vector<double>& out);
+void	rowL1Norms(const MatrixView& view, std::vector<double>& out);
+void	rowMaxAbs(const MatrixView& view, std::vector<double>& out);
+
+void	colSums(const MatrixView& view, std::vector<double>& out);
+void	colNorms(const MatrixView& view, std::vector<double>& out);
+void	colL1Norms(const MatrixView& view, std::vector<double>& out);
+void	colMaxAbs(const MatrixView& view, std::vector<double>& out);
+
+void	rowNorms(const Matrix& m, std::vector<double>& out);
+void	colNorms(const Matrix& m, std::vector<double>& out);
+
+#endif
@@ -3,11 +3,41 @@
 
 #include "Matrix.hpp"
 #include "MatrixView.hpp"
+#include <vector>
 
 // Declaration of Frobenius norm functions
 double frobeniusNorm(const Matrix& m);
 // double frobeniusNorm(const MatrixView& view);
 
+// Norms of many tiles at once, spread over the shared thread pool
+std::vector<double> frobeniusNorms(const std::vector<MatrixView>& views);
+
+/*
+    Pairwise comparison of same-shaped tiles, possibly of different matrices.
+
+    <A, B>_F = sum of a(i, j) * b(i, j)
+    ||A - B||_F is accumulated from the element differences, never through
+    ||A||^2 + ||B||^2 - 2 <A, B>_F, which cancels badly for close tiles.
+
+    Both tiles are streamed once, row span by row span, with the rows split
+    over the shared thread pool; nothing is allocated. The Matrix overloads
+    fold pending Matrix::scale() factors into the kernels.
+    Mismatched shapes throw std::invalid_argument.
+*/
+double frobeniusDot(const MatrixView& a, const MatrixView& b);
+double frobeniusDistance(const MatrixView& a, const MatrixView& b);
+double frobeniusDot(const Matrix& a, const Matrix& b);
+double frobeniusDistance(const Matrix& a, const Matrix& b);
+
+/*
+    One reference against many: out[k] compares ref with others[k].
+    A reference that fits in cache is compared against each tile in turn,
+    tiles split over the pool; a larger one is walked row by row, each row
+    compared against the same row of every tile while it is hot.
+*/
+std::vector<double> frobeniusDots(const MatrixView& ref, const std::vector<MatrixView>& others);
+std::vector<double> frobeniusDistances(const MatrixView& ref, const std::vector<MatrixView>& others);
+
 
 
 #endif // FROBENIUS_HPP
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef GEMV_HPP
+#define GEMV_HPP
+
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	Matrix-vector product over a tile.
+
+		y = alpha * A * x + beta * y		(transposed = false)
+		y = alpha * A^T * x + beta * y		(transposed = true)
+
+	Each row of A is streamed once. The normal product is a dot product
+	per row, split across the thread pool by row blocks; the transposed
+	product adds alpha * x[i] * row_i into y, split by column ranges so
+	that no two threads write the same y entries.
+	With beta == 0, y is not read (NaNs in it are not propagated).
+
+	The vector overloads check the sizes and throw std::invalid_argument;
+	y is resized when beta == 0.
+	A pending Matrix::scale() of A is folded into alpha.
+*/
+void	gemv(const MatrixView& a, const double *x, double *y, double alpha = 1.0, double beta = 0.0,
+			bool transposed = false);
+void	gemv(const MatrixView& a, const std::vector<double>& x, std::vector<double>& y,
+			double alpha = 1.0, double beta = 0.0, bool transposed = false);
+void	gemv(const Matrix& a, const std::vector<double>& x, std::vector<double>& y,
+			double alpha = 1.0, double beta = 0.0, bool transposed = false);
+
+#endif
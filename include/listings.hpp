@@ -4,5 +4,19 @@
 void	ft_listing_1();
 void	ft_listing_2();
 void	ft_listing_3();
+void	ft_listing_4();
+void	ft_listing_5();
+void	ft_listing_6();
+void	ft_listing_7();
+void	ft_listing_8();
+void	ft_listing_9();
+void	ft_listing_10();
+void	ft_listing_11();
+void	ft_listing_12();
+void	ft_listing_13();
+void	ft_listing_14();
+void	ft_listing_15();
+void	ft_listing_16();
+void	ft_listing_17();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef LOWPRECISION_HPP
+#define LOWPRECISION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+	16-bit storage formats.
+
+	bfloat16 is the upper half of a float: same exponent range, 8 bits of
+	significand. float16 is IEEE binary16: 11 bits of significand, finite
+	values up to 65504. Both are plain bit patterns, all arithmetic is done
+	after widening.
+
+	Narrowing rounds to nearest even and goes through float, so a double
+	halfway between two representable values may round twice.
+*/
+struct bfloat16 {
+	uint16_t	bits;
+};
+
+struct float16 {
+	uint16_t	bits;
+};
+
+float		toFloat(bfloat16 value);
+float		toFloat(float16 value);
+bfloat16	toBFloat16(float value);
+float16		toFloat16(float value);
+
+inline double	widen(double value) { return value; }
+inline double	widen(float value) { return value; }
+inline double	widen(bfloat16 value) { return toFloat(value); }
+inline double	widen(float16 value) { return toFloat(value); }
+
+// narrow<T>(x): x rounded to the storage format T
+template <typename T>
+T	narrow(double value);
+
+template <>
+inline float	narrow<float>(double value) { return static_cast<float>(value); }
+template <>
+inline bfloat16	narrow<bfloat16>(double value) { return toBFloat16(static_cast<float>(value)); }
+template <>
+inline float16	narrow<float16>(double value) { return toFloat16(static_cast<float>(value)); }
+
+/*
+	Span kernels. Elements are widened in registers and accumulated in
+	double, with the same four independent accumulators as the double
+	kernels in rowKernels.hpp.
+*/
+
+// sum of x[i]^2 over one span
+double	sumOfSquares(const float *row, size_t n);
+double	sumOfSquares(const bfloat16 *row, size_t n);
+double	sumOfSquares(const float16 *row, size_t n);
+
+// dst[j] = widen(src[j])
+void	widenSpan(double *dst, const float *src, size_t n);
+void	widenSpan(double *dst, const bfloat16 *src, size_t n);
+void	widenSpan(double *dst, const float16 *src, size_t n);
+
+// dst[j] = narrow(src[j])
+void	narrowSpan(float *dst, const double *src, size_t n);
+void	narrowSpan(bfloat16 *dst, const double *src, size_t n);
+void	narrowSpan(float16 *dst, const double *src, size_t n);
+
+#endif
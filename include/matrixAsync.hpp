@@ -0,0 +1,20 @@
+#ifndef MATRIXASYNC_HPP
+#define MATRIXASYNC_HPP
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "Future.hpp"
+
+/*
+	Asynchronous versions of the long-running Matrix operations.
+
+	They run on the shared thread pool and poll the future's cancellation
+	token between chunks of rows. The source matrix must outlive the
+	returned future; views are copied, the matrix behind them is not.
+*/
+Future<double>	frobeniusNormAsync(const Matrix& m);
+Future<double>	frobeniusNormAsync(const MatrixView& view);
+Future<Matrix>	copyAsync(const Matrix& m);
+Future<Matrix>	materializeAsync(const MatrixView& view);
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef REDUCE_HPP
+#define REDUCE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+#include "ThreadPool.hpp"
+
+/*
+	Single-pass multi-reduction over a Matrix or MatrixView.
+
+	A reducer describes one statistic:
+		State	init() const
+		void	accumulate(State &, const double *span, size_t n) const
+		void	merge(State &, const State &) const
+		Result	finish(const State &, size_t count) const
+
+	reduce(view, R1(), R2(), ...) walks each row once in L1-sized spans,
+	feeds every span to every reducer while it is still in cache, splits
+	the rows over the shared thread pool and returns the results as a
+	std::tuple in argument order.
+*/
+
+struct SumReducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return 0; }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+		size_t j = 0;
+		for (; j + 4 <= n; j += 4)
+		{
+			a0 += x[j];
+			a1 += x[j + 1];
+			a2 += x[j + 2];
+			a3 += x[j + 3];
+		}
+		for (; j < n; j++)
+			a0 += x[j];
+		s += (a0 + a1) + (a2 + a3);
+	}
+	void	merge(State &s, const State &other) const { s += other; }
+	Result	finish(const State &s, size_t) const { return s; }
+};
+
+// arithmetic mean, NaN for an empty range
+struct MeanReducer : SumReducer {
+	Result	finish(const State &s, size_t count) const { return s / count; }
+};
+
+struct L1Reducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return 0; }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+		size_t j = 0;
+		for (; j + 4 <= n; j += 4)
+		{
+			a0 += std::fabs(x[j]);
+			a1 += std::fabs(x[j + 1]);
+			a2 += std::fabs(x[j + 2]);
+			a3 += std::fabs(x[j + 3]);
+		}
+		for (; j < n; j++)
+			a0 += std::fabs(x[j]);
+		s += (a0 + a1) + (a2 + a3);
+	}
+	void	merge(State &s, const State &other) const { s += other; }
+	Result	finish(const State &s, size_t) const { return s; }
+};
+
+struct FrobeniusReducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return 0; }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+		size_t j = 0;
+		for (; j + 4 <= n; j += 4)
+		{
+			a0 += x[j] * x[j];
+			a1 += x[j + 1] * x[j + 1];
+			a2 += x[j + 2] * x[j + 2];
+			a3 += x[j + 3] * x[j + 3];
+		}
+		for (; j < n; j++)
+			a0 += x[j] * x[j];
+		s += (a0 + a1) + (a2 + a3);
+	}
+	void	merge(State &s, const State &other) const { s += other; }
+	Result	finish(const State &s, size_t) const { return std::sqrt(s); }
+};
+
+// +infinity for an empty range
+struct MinReducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return std::numeric_limits<double>::infinity(); }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		for (size_t j = 0; j < n; j++)
+			s = x[j] < s ? x[j] : s;
+	}
+	void	merge(State &s, const State &other) const { s = std::min(s, other); }
+	Result	finish(const State &s, size_t) const { return s; }
+};
+
+// -infinity for an empty range
+struct MaxReducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return -std::numeric_limits<double>::infinity(); }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		for (size_t j = 0; j < n; j++)
+			s = x[j] > s ? x[j] : s;
+	}
+	void	merge(State &s, const State &other) const { s = std::max(s, other); }
+	Result	finish(const State &s, size_t) const { return s; }
+};
+
+struct MaxAbsReducer {
+	typedef double State;
+	typedef double Result;
+
+	State	init() const { return 0; }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		for (size_t j = 0; j < n; j++)
+			s = std::fabs(x[j]) > s ? std::fabs(x[j]) : s;
+	}
+	void	merge(State &s, const State &other) const { s = std::max(s, other); }
+	Result	finish(const State &s, size_t) const { return s; }
+};
+
+/*
+	Population variance. Each span is reduced to (count, mean, M2) with a
+	second pass while it is in L1, spans are combined with Chan's formula,
+	which avoids the cancellation of sum(x^2) - n * mean^2.
+*/
+struct VarianceReducer {
+	struct State {
+		double	count;
+		double	mean;
+		double	m2;
+	};
+	typedef double Result;
+
+	State	init() const { State s = {0, 0, 0}; return s; }
+	void	accumulate(State &s, const double *x, size_t n) const
+	{
+		if (n == 0)
+			return;
+		double sum = 0;
+		for (size_t j = 0; j < n; j++)
+			sum += x[j];
+		double mean = sum / n;
+		double m2 = 0;
+		for (size_t j = 0; j < n; j++)
+			m2 += (x[j] - mean) * (x[j] - mean);
+		State span = {static_cast<double>(n), mean, m2};
+		merge(s, span);
+	}
+	void	merge(State &s, const State &other) const
+	{
+		if (other.count == 0)
+			return;
+		double count = s.count + other.count;
+		double delta = other.mean - s.mean;
+		s.m2 += other.m2 + delta * delta * s.count * other.count / count;
+		s.mean += delta * other.count / count;
+		s.count = count;
+	}
+	Result	finish(const State &s, size_t) const { return s.count > 0 ? s.m2 / s.count : 0; }
+};
+
+namespace reduce_detail {
+
+// elements per span: 2 KiB, leaves room in L1 for every reducer's pass
+const size_t SPAN = 256;
+
+template <typename... R, size_t... I>
+void accumulateAll(const std::tuple<R...> &reducers, std::tuple<typename R::State...> &states,
+	const double *x, size_t n, std::index_sequence<I...>)
+{
+	(std::get<I>(reducers).accumulate(std::get<I>(states), x, n), ...);
+}
+
+template <typename... R, size_t... I>
+void mergeAll(const std::tuple<R...> &reducers, std::tuple<typename R::State...> &states,
+	const std::tuple<typename R::State...> &other, std::index_sequence<I...>)
+{
+	(std::get<I>(reducers).merge(std::get<I>(states), std::get<I>(other)), ...);
+}
+
+template <typename... R, size_t... I>
+std::tuple<typename R::Result...> finishAll(const std::tuple<R...> &reducers,
+	const std::tuple<typename R::State...> &states, size_t count, std::index_sequence<I...>)
+{
+	return std::tuple<typename R::Result...>(std::get<I>(reducers).finish(std::get<I>(states), count)...);
+}
+
+// scale != 1 multiplies each span into an L1-sized buffer first, the rows stay as stored
+template <typename... R>
+std::tuple<typename R::Result...> reduceTile(double **rows, size_t startRow, size_t startCol,
+	size_t numRows, size_t numCols, const std::tuple<R...> &reducers, double scale = 1.0)
+{
+	typedef std::tuple<typename R::State...> States;
+	typedef std::index_sequence_for<R...> Indices;
+	States identity(std::apply([](const R &...r) { return States(r.init()...); }, reducers));
+
+	States total = ThreadPool::instance().parallelReduce(startRow, startRow + numRows, numCols, identity,
+		[&](size_t lo, size_t hi) {
+			States states = identity;
+			double span[SPAN];
+			for (size_t i = lo; i < hi; i++)
+			{
+				const double *row = rows[i] + startCol;
+				for (size_t j = 0; j < numCols; j += SPAN)
+				{
+					size_t n = std::min(SPAN, numCols - j);
+					if (scale == 1.0)
+					{
+						accumulateAll(reducers, states, row + j, n, Indices());
+						continue;
+					}
+					for (size_t k = 0; k < n; k++)
+						span[k] = scale * row[j + k];
+					accumulateAll(reducers, states, span, n, Indices());
+				}
+			}
+			return states;
+		},
+		[&](States a, const States &b) {
+			mergeAll(reducers, a, b, Indices());
+			return a;
+		});
+	return finishAll(reducers, total, numRows * numCols, Indices());
+}
+
+}
+
+template <typename... R>
+std::tuple<typename R::Result...> reduce(const MatrixView &view, R... reducers)
+{
+	return reduce_detail::reduceTile(view.matrix_ptr, view.getStartRow(), view.getStartCol(),
+		view.getRows(), view.getCols(), std::tuple<R...>(reducers...));
+}
+
+template <typename... R>
+std::tuple<typename R::Result...> reduce(const Matrix &m, R... reducers)
+{
+	return reduce_detail::reduceTile(m.getRawMatrix(), 0, 0, m.getRows(), m.getCols(), std::tuple<R...>(reducers...),
+		m.getPendingScale());
+}
+
+/*
+	Every built-in statistic of a tile from one pass.
+*/
+struct TileStatistics {
+	double	sum;
+	double	mean;
+	double	variance;
+	double	min;
+	double	max;
+	double	l1;
+	double	maxAbs;
+	double	frobenius;
+};
+
+TileStatistics	statistics(const MatrixView &view);
+TileStatistics	statistics(const Matrix &m);
+
+#endif
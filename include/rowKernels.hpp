@@ -0,0 +1,74 @@
+#ifndef ROWKERNELS_HPP
+#define ROWKERNELS_HPP
+
+#include <cstddef>
+
+/*
+	Kernels over contiguous row spans.
+
+	The row-range versions take the row pointer table of a Matrix
+	(getMatrix() / MatrixView::matrix_ptr) and split the rows across the
+	shared thread pool.
+*/
+
+// sum of x[i]^2 over one span
+double	sumOfSquares(const double *row, size_t n);
+
+// sum of a[i] * b[i] over one span
+double	dot(const double *a, const double *b, size_t n);
+
+// sum of (alpha * a[i] - beta * b[i])^2 over one span
+double	squaredDistance(const double *a, const double *b, size_t n, double alpha = 1.0, double beta = 1.0);
+
+// y[i] += alpha * x[i] over one span
+void	axpy(double alpha, const double *x, double *y, size_t n);
+
+// x[i] *= alpha over one span, returns the sum of squares from before the scaling
+double	scaleSpan(double *row, size_t n, double alpha);
+
+// sum of squares of the numRows x numCols tile at (startRow, startCol)
+double	sumOfSquares(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols);
+
+// scales the tile in place, in parallel, and returns its sum of squares from before
+double	scaleTile(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols, double alpha);
+
+/*
+	Destinations of at least STREAMING_COPY_BYTES are written with
+	non-temporal stores: they would not fit in the last-level cache anyway,
+	and streaming them skips the read-for-ownership of every target line.
+	A freshly allocated destination is page-faulted in by the first write
+	regardless, and plain stores measure faster there.
+*/
+const size_t STREAMING_COPY_BYTES = size_t(32) << 20;
+
+// dst[j] = src[j] over one span, optionally with non-temporal stores
+void	copySpan(double *dst, const double *src, size_t n, bool streaming = false);
+
+// dst[i][j] = src[i][j] for the given rows, in parallel
+void	copyRows(double **dst, double **src, size_t numRows, size_t numCols, bool freshDestination = false);
+
+// dst[i][j] = src[startRow + i][startCol + j] for a numRows x numCols tile, in parallel
+void	copyTile(double **dst, double **src, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+			bool freshDestination = false);
+
+/*
+	Gather kernels over rows picked by index: rows[i] points at the first
+	element of row i, and cols, when not NULL, picks numCols elements
+	inside each row (otherwise the first numCols are taken). The hardware
+	prefetcher follows a row once it is streaming but cannot guess the
+	jump to the next one, so the row PREFETCH_ROWS ahead is prefetched
+	while the current one is processed. Rows are split across the shared
+	thread pool.
+*/
+const size_t PREFETCH_ROWS = 4;
+
+// sum of squares of the gathered elements
+double	gatherSumOfSquares(double *const *rows, size_t numRows, const size_t *cols, size_t numCols);
+
+// dst[i][k] = rows[i][k], or rows[i][cols[k]]
+void	gatherRows(double **dst, double *const *rows, size_t numRows, const size_t *cols, size_t numCols);
+
+// rows[i][j] = value for every row, in parallel
+void	fillRows(double **rows, size_t numRows, size_t numCols, double value);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SPECTRALNORM_HPP
+#define SPECTRALNORM_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	Operator 2-norm and nuclear norm estimates built on gemv.
+
+	spectralNormEstimate runs power iteration on A^T A, two streamed
+	passes over the tile per iteration, and stops once the estimate moves
+	by less than tol (relative). The right singular vector it ends on can
+	warm-start the next, similar tile.
+
+	nuclearNormEstimate runs `steps` Golub-Kahan-Lanczos bidiagonalisation
+	steps and sums the singular values of the small bidiagonal matrix:
+	exact when steps >= rank, otherwise the sum of the leading singular
+	values (a lower bound).
+*/
+struct SpectralEstimate {
+	double				value;
+	size_t				iterations;
+	bool				converged;
+	std::vector<double>	rightVector;
+};
+
+SpectralEstimate	spectralNormEstimate(const MatrixView& view, double tol, size_t maxIter,
+						const std::vector<double>& warmStart);
+double				spectralNormEstimate(const MatrixView& view, double tol = 1e-6, size_t maxIter = 100);
+
+double				nuclearNormEstimate(const MatrixView& view, size_t steps = 32);
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef TRANSPOSE_HPP
+#define TRANSPOSE_HPP
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	Cache-blocked transpose.
+
+	The tile is walked in 32x32 blocks (both blocks stay in L1) made of
+	4x4 register transposes (AVX when the build targets it, scalar
+	otherwise). Block rows are split across the shared thread pool.
+
+	dst must be src.getCols() x src.getRows() and must not overlap src
+	unless both are the same square tile, which is then transposed in
+	place. The destination's cached sum of squares takes the source's;
+	the parent matrix of dst has its cache invalidated.
+*/
+void	transpose(const MatrixView& src, MatrixView& dst);
+Matrix	transpose(const Matrix& m);
+
+// square tiles / matrices only, throws std::invalid_argument otherwise
+void	transposeInPlace(MatrixView& view);
+void	transposeInPlace(Matrix& m);
+
+#endif
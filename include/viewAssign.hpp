@@ -0,0 +1,33 @@
+#ifndef VIEWASSIGN_HPP
+#define VIEWASSIGN_HPP
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+/*
+	Bulk writes of whole tiles.
+
+	assign(dst, src)	dst(i, j) = src(i, j)
+	fill(view, value)	view(i, j) = value
+	swapTiles(a, b)		exchanges the elements of a and b
+
+	Rows are processed as contiguous spans split across the shared thread
+	pool, and the old sum of squares of each written tile is accumulated
+	in the same pass. The written views' caches become exact and their
+	parent matrices get the delta through addToSum(), as with apply().
+
+	assign accepts any overlap between src and dst and behaves as if src
+	were copied out first: tiles on the same rows are moved row by row,
+	other overlaps go through a temporary. swapTiles throws
+	std::invalid_argument on overlapping tiles; views of one matrix taken
+	through different row tables (before and after a growth) count as
+	overlapping. Mismatched dimensions throw std::invalid_argument.
+
+	fill skips row groups of the parent that are still untouched when the
+	value is zero.
+*/
+void	assign(MatrixView& dst, const MatrixView& src);
+void	fill(MatrixView& view, double value);
+void	swapTiles(MatrixView& a, MatrixView& b);
+
+#endif
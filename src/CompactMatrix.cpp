@@ -0,0 +1,253 @@
+#include "../include/CompactMatrix.hpp"
+#include <functional>
+#include <stdexcept>
+
+/*
+
+	Constructors
+
+*/
+
+template <typename T>
+CompactMatrix<T>::CompactMatrix(size_t rows, size_t cols)
+	: rows(rows), cols(cols), data(rows * cols), sum(0), sumComputed(true)
+{
+}
+
+template <typename T>
+CompactMatrix<T>::CompactMatrix(const Matrix &source)
+	: rows(source.getRows()), cols(source.getCols()), data(rows * cols), sum(0), sumComputed(false)
+{
+	narrowFrom(source.getRawMatrix(), 0, 0, source.getPendingScale());
+}
+
+template <typename T>
+CompactMatrix<T>::CompactMatrix(const MatrixView &source)
+	: rows(source.getRows()), cols(source.getCols()), data(rows * cols), sum(0), sumComputed(false)
+{
+	narrowFrom(source.matrix_ptr, source.getStartRow(), source.getStartCol());
+}
+
+template <typename T>
+void CompactMatrix<T>::narrowFrom(double **source, size_t startRow, size_t startCol, double scale)
+{
+	T *dst = this->data.data();
+	size_t cols = this->cols;
+	ThreadPool::instance().parallelFor(0, this->rows, cols, [=](size_t lo, size_t hi) {
+		double span[reduce_detail::SPAN];
+		for (size_t i = lo; i < hi; i++)
+		{
+			const double *row = source[startRow + i] + startCol;
+			if (scale == 1.0)
+			{
+				narrowSpan(dst + i * cols, row, cols);
+				continue;
+			}
+			// scaled through an L1-sized buffer, the source stays as stored
+			for (size_t j = 0; j < cols; j += reduce_detail::SPAN)
+			{
+				size_t n = std::min(reduce_detail::SPAN, cols - j);
+				for (size_t k = 0; k < n; k++)
+					span[k] = scale * row[j + k];
+				narrowSpan(dst + i * cols + j, span, n);
+			}
+		}
+	});
+}
+
+/*
+
+	Getters
+
+*/
+
+template <typename T>
+size_t CompactMatrix<T>::getRows() const
+{
+	return this->rows;
+}
+
+template <typename T>
+size_t CompactMatrix<T>::getCols() const
+{
+	return this->cols;
+}
+
+template <typename T>
+size_t CompactMatrix<T>::getBytes() const
+{
+	return this->data.size() * sizeof(T);
+}
+
+template <typename T>
+const T *CompactMatrix<T>::getRow(size_t row) const
+{
+	return this->data.data() + row * this->cols;
+}
+
+/*
+
+	Access
+
+*/
+
+template <typename T>
+double CompactMatrix<T>::getValue(size_t row, size_t col) const
+{
+	if (row >= this->rows || col >= this->cols)
+		throw std::out_of_range("CompactMatrix indices are out of range");
+	return widen(this->data[row * this->cols + col]);
+}
+
+template <typename T>
+void CompactMatrix<T>::setValue(size_t row, size_t col, double value)
+{
+	if (row >= this->rows || col >= this->cols)
+		throw std::out_of_range("CompactMatrix indices are out of range");
+	T &slot = this->data[row * this->cols + col];
+	double before = widen(slot);
+	slot = narrow<T>(value);
+	double after = widen(slot);
+	if (this->sumComputed)
+		this->sum += after * after - before * before;
+}
+
+/*
+
+	Conversion and norm
+
+*/
+
+template <typename T>
+Matrix CompactMatrix<T>::toMatrix() const
+{
+	Matrix result = view(0, 0, this->rows, this->cols).toMatrix();
+	if (this->sumComputed)
+	{
+		result.setSum(this->sum);
+		result.setSumComputed(true);
+	}
+	return result;
+}
+
+template <typename T>
+double CompactMatrix<T>::frobeniusNorm() const
+{
+	if (!this->sumComputed)
+	{
+		const T *base = this->data.data();
+		size_t cols = this->cols;
+		this->sum = ThreadPool::instance().parallelReduce(0, this->rows, cols, 0.0,
+			[=](size_t lo, size_t hi) {
+				// the rows of [lo, hi) are one contiguous span
+				return sumOfSquares(base + lo * cols, (hi - lo) * cols);
+			}, std::plus<double>());
+		this->sumComputed = true;
+	}
+	return std::sqrt(std::max(0.0, this->sum));
+}
+
+template <typename T>
+CompactMatrixView<T> CompactMatrix<T>::view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+{
+	return CompactMatrixView<T>(*this, startRow, startCol, numRows, numCols);
+}
+
+/*
+
+	View
+
+*/
+
+template <typename T>
+CompactMatrixView<T>::CompactMatrixView(const CompactMatrix<T> &matrix, size_t startRow, size_t startCol,
+	size_t numRows, size_t numCols)
+	: matrix(matrix), rows(numRows), cols(numCols), startRow(startRow), startCol(startCol), sum(0),
+	sumComputed(false)
+{
+	if (startRow + numRows > matrix.getRows() || startCol + numCols > matrix.getCols())
+		throw std::out_of_range("CompactMatrixView exceeds the matrix");
+}
+
+template <typename T>
+const CompactMatrix<T> &CompactMatrixView<T>::getMatrix() const
+{
+	return this->matrix;
+}
+
+template <typename T>
+size_t CompactMatrixView<T>::getRows() const
+{
+	return this->rows;
+}
+
+template <typename T>
+size_t CompactMatrixView<T>::getCols() const
+{
+	return this->cols;
+}
+
+template <typename T>
+size_t CompactMatrixView<T>::getStartRow() const
+{
+	return this->startRow;
+}
+
+template <typename T>
+size_t CompactMatrixView<T>::getStartCol() const
+{
+	return this->startCol;
+}
+
+template <typename T>
+const T *CompactMatrixView<T>::getRow(size_t row) const
+{
+	return this->matrix.getRow(this->startRow + row) + this->startCol;
+}
+
+template <typename T>
+double CompactMatrixView<T>::getValue(size_t row, size_t col) const
+{
+	if (row >= this->rows || col >= this->cols)
+		throw std::out_of_range("CompactMatrixView indices are out of range");
+	return widen(getRow(row)[col]);
+}
+
+template <typename T>
+double CompactMatrixView<T>::frobeniusNorm() const
+{
+	if (!this->sumComputed)
+	{
+		size_t cols = this->cols;
+		this->sum = ThreadPool::instance().parallelReduce(0, this->rows, cols, 0.0,
+			[this, cols](size_t lo, size_t hi) {
+				double sum = 0;
+				for (size_t i = lo; i < hi; i++)
+					sum += sumOfSquares(getRow(i), cols);
+				return sum;
+			}, std::plus<double>());
+		this->sumComputed = true;
+	}
+	return std::sqrt(this->sum);
+}
+
+template <typename T>
+Matrix CompactMatrixView<T>::toMatrix() const
+{
+	Matrix result(this->rows, this->cols);
+	double **dst = result.getRawMatrix();
+	size_t cols = this->cols;
+	ThreadPool::instance().parallelFor(0, this->rows, cols, [this, dst, cols](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+			widenSpan(dst[i], getRow(i), cols);
+	});
+	result.markWritten(0, this->rows);
+	return result;
+}
+
+template class CompactMatrix<float>;
+template class CompactMatrix<bfloat16>;
+template class CompactMatrix<float16>;
+template class CompactMatrixView<float>;
+template class CompactMatrixView<bfloat16>;
+template class CompactMatrixView<float16>;
@@ -0,0 +1,63 @@
+#include "../include/ConstMatrixView.hpp"
+#include "../include/rowKernels.hpp"
+#include <cmath>
+#include <stdexcept>
+
+ConstMatrixView::ConstMatrixView(const Matrix &matrix, size_t startRow, size_t startCol,
+	size_t numRows, size_t numCols)
+	: table(matrix.getRawMatrix()), scale(matrix.getPendingScale()), rows(numRows), cols(numCols),
+	startRow(startRow), startCol(startCol), sum(0), sumComputed(false)
+{
+	if (startRow + numRows > matrix.getRows() || startCol + numCols > matrix.getCols())
+		throw std::out_of_range("ConstMatrixView exceeds the matrix");
+}
+
+size_t ConstMatrixView::getRows() const
+{
+	return this->rows;
+}
+
+size_t ConstMatrixView::getCols() const
+{
+	return this->cols;
+}
+
+size_t ConstMatrixView::getStartRow() const
+{
+	return this->startRow;
+}
+
+size_t ConstMatrixView::getStartCol() const
+{
+	return this->startCol;
+}
+
+double ConstMatrixView::getValue(size_t row, size_t col) const
+{
+	if (row >= this->rows || col >= this->cols)
+		throw std::out_of_range("ConstMatrixView indices are out of range");
+	return this->scale * this->table[this->startRow + row][this->startCol + col];
+}
+
+double ConstMatrixView::operator()(size_t row, size_t col) const
+{
+	return getValue(row, col);
+}
+
+double ConstMatrixView::frobeniusNorm() const
+{
+	if (!this->sumComputed)
+	{
+		this->sum = this->scale * this->scale
+			* sumOfSquares(this->table, this->startRow, this->startCol, this->rows, this->cols);
+		this->sumComputed = true;
+	}
+	return std::sqrt(this->sum);
+}
+
+Matrix ConstMatrixView::toMatrix() const
+{
+	Matrix result = Matrix::fromRows(this->table, this->startRow, this->startCol, this->rows, this->cols);
+	result.scale(this->scale);
+	return result;
+}
@@ -0,0 +1,255 @@
+#include "../include/IndexedView.hpp"
+#include "../include/rowKernels.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// indices already checked against n
+bool allDistinct(const std::vector<size_t> &indices, size_t n)
+{
+	std::vector<bool> seen(n, false);
+	for (size_t k = 0; k < indices.size(); k++)
+	{
+		if (seen[indices[k]])
+			return false;
+		seen[indices[k]] = true;
+	}
+	return true;
+}
+
+bool isPermutation(const std::vector<size_t> &perm, size_t n)
+{
+	if (perm.size() != n)
+		return false;
+	std::vector<bool> seen(n, false);
+	for (size_t k = 0; k < n; k++)
+	{
+		if (perm[k] >= n || seen[perm[k]])
+			return false;
+		seen[perm[k]] = true;
+	}
+	return true;
+}
+
+}
+
+/*
+
+	Construction
+
+	The row pointers are resolved once, through the parent's table at the
+	time of construction; column indices are kept relative to the row
+	start, i.e. as columns of the parent matrix.
+
+*/
+
+IndexedView::IndexedView(Matrix &matrix, const MatrixView *tile, const std::vector<size_t> &rows,
+	const std::vector<size_t> *cols)
+	: matrix(matrix), rowPtrs(rows.size()), rowIndex(rows.size()), numCols(0), firstCol(0),
+	contiguous(cols == NULL), distinct(true), sum(0), sumComputed(false)
+{
+	double **table;
+	size_t startRow = 0, startCol = 0, tileRows, tileCols;
+	if (tile == NULL)
+	{
+		this->storage = matrix.shareStorage();
+		table = matrix.getRawMatrix();
+		tileRows = matrix.getRows();
+		tileCols = matrix.getCols();
+	}
+	else
+	{
+		this->storage = tile->storage;
+		table = tile->matrix_ptr;
+		startRow = tile->getStartRow();
+		startCol = tile->getStartCol();
+		tileRows = tile->getRows();
+		tileCols = tile->getCols();
+	}
+
+	for (size_t i = 0; i < rows.size(); i++)
+	{
+		if (rows[i] >= tileRows)
+			throw std::out_of_range("IndexedView row index out of range");
+		this->rowIndex[i] = startRow + rows[i];
+		this->rowPtrs[i] = table[this->rowIndex[i]] + (this->contiguous ? startCol : 0);
+	}
+	this->distinct = allDistinct(rows, tileRows);
+	if (this->contiguous)
+	{
+		this->numCols = tileCols;
+		this->firstCol = startCol;
+		return;
+	}
+	this->numCols = cols->size();
+	this->colIndex.resize(cols->size());
+	for (size_t j = 0; j < cols->size(); j++)
+	{
+		if ((*cols)[j] >= tileCols)
+			throw std::out_of_range("IndexedView column index out of range");
+		this->colIndex[j] = startCol + (*cols)[j];
+	}
+	this->distinct = this->distinct && allDistinct(*cols, tileCols);
+}
+
+IndexedView::IndexedView(Matrix &matrix, const std::vector<size_t> &rows, const std::vector<size_t> &cols)
+	: IndexedView(matrix, NULL, rows, &cols)
+{
+}
+
+IndexedView::IndexedView(const MatrixView &tile, const std::vector<size_t> &rows, const std::vector<size_t> &cols)
+	: IndexedView(tile.matrix, &tile, rows, &cols)
+{
+}
+
+IndexedView IndexedView::selectRows(Matrix &matrix, const std::vector<size_t> &rows)
+{
+	return IndexedView(matrix, NULL, rows, NULL);
+}
+
+IndexedView IndexedView::selectRows(const MatrixView &tile, const std::vector<size_t> &rows)
+{
+	return IndexedView(tile.matrix, &tile, rows, NULL);
+}
+
+IndexedView IndexedView::selectCols(Matrix &matrix, const std::vector<size_t> &cols)
+{
+	std::vector<size_t> rows(matrix.getRows());
+	for (size_t i = 0; i < rows.size(); i++)
+		rows[i] = i;
+	return IndexedView(matrix, NULL, rows, &cols);
+}
+
+/*
+
+	Permutations
+
+	Every element of the matrix appears exactly once, so a cached norm of
+	the parent is the norm of the view.
+
+*/
+
+IndexedView IndexedView::permuteRows(Matrix &matrix, const std::vector<size_t> &perm)
+{
+	if (!isPermutation(perm, matrix.getRows()))
+		throw std::invalid_argument("permuteRows: not a permutation of the rows");
+	IndexedView view = selectRows(matrix, perm);
+	view.sum = matrix.getSum();
+	view.sumComputed = matrix.getSumComputed();
+	return view;
+}
+
+IndexedView IndexedView::permuteCols(Matrix &matrix, const std::vector<size_t> &perm)
+{
+	if (!isPermutation(perm, matrix.getCols()))
+		throw std::invalid_argument("permuteCols: not a permutation of the columns");
+	IndexedView view = selectCols(matrix, perm);
+	view.sum = matrix.getSum();
+	view.sumComputed = matrix.getSumComputed();
+	return view;
+}
+
+IndexedView IndexedView::permute(Matrix &matrix, const std::vector<size_t> &rowPerm, const std::vector<size_t> &colPerm)
+{
+	if (!isPermutation(rowPerm, matrix.getRows()) || !isPermutation(colPerm, matrix.getCols()))
+		throw std::invalid_argument("permute: not a permutation of the rows and columns");
+	IndexedView view(matrix, NULL, rowPerm, &colPerm);
+	view.sum = matrix.getSum();
+	view.sumComputed = matrix.getSumComputed();
+	return view;
+}
+
+/*
+
+	Access
+
+*/
+
+size_t IndexedView::getRows() const
+{
+	return this->rowPtrs.size();
+}
+
+size_t IndexedView::getCols() const
+{
+	return this->numCols;
+}
+
+bool IndexedView::allColumns() const
+{
+	return this->contiguous;
+}
+
+size_t IndexedView::parentRow(size_t i) const
+{
+	return this->rowIndex.at(i);
+}
+
+size_t IndexedView::parentCol(size_t j) const
+{
+	if (j >= this->numCols)
+		throw std::out_of_range("IndexedView column out of range");
+	return this->contiguous ? this->firstCol + j : this->colIndex[j];
+}
+
+double IndexedView::getValue(size_t row, size_t col) const
+{
+	if (row >= getRows() || col >= this->numCols)
+		throw std::out_of_range("IndexedView indices are out of range");
+	return this->rowPtrs[row][this->contiguous ? col : this->colIndex[col]];
+}
+
+/*
+	With repeated indices one write changes every copy of the element in
+	the view, so the view's sum is dropped rather than updated; the parent
+	always changes by one element.
+*/
+void IndexedView::setValue(size_t row, size_t col, double value)
+{
+	if (row >= getRows() || col >= this->numCols)
+		throw std::out_of_range("IndexedView indices are out of range");
+	double &element = this->rowPtrs[row][this->contiguous ? col : this->colIndex[col]];
+	double delta = value * value - element * element;
+	if (this->distinct)
+		this->sum += delta;
+	else
+		this->sumComputed = false;
+	this->matrix.addToSum(delta);
+	if (this->storage)
+		this->storage->markWritten(this->rowIndex[row], this->rowIndex[row] + 1);
+	element = value;
+}
+
+/*
+
+	Gather
+
+*/
+
+double IndexedView::frobeniusNorm() const
+{
+	if (!this->sumComputed)
+	{
+		this->sum = gatherSumOfSquares(this->rowPtrs.data(), getRows(),
+			this->contiguous ? NULL : this->colIndex.data(), this->numCols);
+		this->sumComputed = true;
+	}
+	return std::sqrt(this->sum);
+}
+
+Matrix IndexedView::toMatrix() const
+{
+	Matrix result(getRows(), this->numCols);
+	gatherRows(result.getRawMatrix(), this->rowPtrs.data(), getRows(),
+		this->contiguous ? NULL : this->colIndex.data(), this->numCols);
+	result.markWritten(0, getRows());
+	result.setSum(this->sum);
+	result.setSumComputed(this->sumComputed);
+	return result;
+}
+
+IndexedView::operator Matrix() const
+{
+	return toMatrix();
+}
@@ -1,45 +1,268 @@
 #include "../include/Matrix.hpp"
+#include "../include/MatrixArena.hpp"
 #include "../include/MatrixView.hpp"
+#include "../include/rowKernels.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <new>
 #include <iostream>
+#include <stdexcept>
+#include <thread>
 
 /*
 
- Constructors
+ Storage
+
+ Rows point into blocks of contiguous storage: one block for the rows
+ allocated at construction, one more each time the row capacity grows.
+ The row table always has rowCapacity entries, the ones past rows point
+ at reserved space, so growing never moves an existing row.
+
+ Blocks and tables belong to a shared MatrixStorage. A replaced table is
+ kept with it, so a view made before a growth still reads the same rows,
+ and a view outliving its matrix keeps the data alive.
+
+ Small matrices use the inline buffers instead and have no MatrixStorage
+ until spill() moves them out.
 
 */
 
-Matrix::Matrix(size_t rows, size_t cols)
-	: rows(rows), cols(cols), sum(0)
+MatrixStorage::~MatrixStorage()
+{
+	for (size_t b = 0; b < blocks.size(); b++)
+		std::free(blocks[b]);
+	for (size_t t = 0; t < tables.size(); t++)
+		delete[] tables[t];
+}
+
+void MatrixStorage::track(size_t rows)
+{
+	size_t groups = (rows + ZERO_BLOCK_ROWS - 1) / ZERO_BLOCK_ROWS;
+	untouched.reset(new std::atomic<bool>[groups]);
+	for (size_t b = 0; b < groups; b++)
+		untouched[b].store(true, std::memory_order_relaxed);
+	trackedRows = rows;
+}
+
+// every row counts as written from now on
+void MatrixStorage::untrack()
+{
+	untouched.reset();
+	trackedRows = 0;
+}
+
+double MatrixStorage::sumOfSquares(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+{
+	double total = 0;
+	forEachWritten(startRow, startRow + numRows, [&](size_t lo, size_t hi) {
+		total += ::sumOfSquares(rows, lo, startCol, hi - lo, numCols);
+	});
+	return total;
+}
+
+// malloc'd so that zero storage can come from calloc's lazily mapped pages
+static double *allocateBlock(size_t elements, bool zero)
+{
+	void *block = zero ? std::calloc(std::max<size_t>(1, elements), sizeof(double))
+		: std::malloc(std::max<size_t>(1, elements) * sizeof(double));
+	if (block == NULL)
+		throw std::bad_alloc();
+	return static_cast<double *>(block);
+}
+
+void Matrix::allocate(size_t rowCapacity, size_t cols, bool zero)
+{
+	if (rowCapacity > INLINE_ELEMENTS || rowCapacity * cols > INLINE_ELEMENTS)
+	{
+		allocateShared(rowCapacity, cols, zero);
+		return;
+	}
+	this->storage.reset();
+	if (zero)
+		std::fill(this->inlineData, this->inlineData + rowCapacity * cols, 0.0);
+	for (size_t i = 0; i < rowCapacity; i++)
+		this->inlineRows[i] = this->inlineData + i * cols;
+	this->matrix = this->inlineRows;
+	this->rowCapacity = rowCapacity;
+}
+
+void Matrix::allocateShared(size_t rowCapacity, size_t cols, bool zero)
+{
+	MatrixArena *arena = MatrixArena::current();
+	if (arena != NULL)
+	{
+		// Temporaries are small and short-lived, zero blocks are cleared
+		// rather than tracked. The block and table stay out of the
+		// storage's lists: the pool, kept alive by the storage's
+		// allocator, owns them.
+		this->storage = std::allocate_shared<MatrixStorage>(ArenaAllocator<MatrixStorage>(arena->getPool()));
+		double *block = static_cast<double *>(arena->allocate(rowCapacity * cols * sizeof(double), zero));
+		this->matrix = static_cast<double **>(arena->allocate(rowCapacity * sizeof(double *)));
+		for (size_t i = 0; i < rowCapacity; i++)
+			this->matrix[i] = block + i * cols;
+		this->rowCapacity = rowCapacity;
+		return;
+	}
+	double *block = allocateBlock(rowCapacity * cols, zero);
+	this->storage = std::make_shared<MatrixStorage>();
+	this->storage->blocks.push_back(block);
+	if (zero)
+		this->storage->track(rowCapacity);
+	this->matrix = new double *[rowCapacity];
+	this->storage->tables.push_back(this->matrix);
+	for (size_t i = 0; i < rowCapacity; i++)
+		this->matrix[i] = block + i * cols;
+	this->rowCapacity = rowCapacity;
+}
+
+bool Matrix::isInline() const
+{
+	return this->matrix == this->inlineRows;
+}
+
+// same rows and capacity, on the heap
+void Matrix::spill()
+{
+	double **old = this->matrix;
+	allocateShared(this->rowCapacity, this->cols, false);
+	for (size_t i = 0; i < this->rows; i++)
+		std::copy(old[i], old[i] + this->cols, this->matrix[i]);
+}
+
+void Matrix::takeInline(const Matrix &other) noexcept
+{
+	std::copy(other.inlineData, other.inlineData + other.rowCapacity * other.cols, this->inlineData);
+	for (size_t i = 0; i < other.rowCapacity; i++)
+		this->inlineRows[i] = this->inlineData + i * other.cols;
+	this->matrix = this->inlineRows;
+}
+
+void Matrix::release()
+{
+	this->storage.reset();
+	this->matrix = NULL;
+	this->rowCapacity = 0;
+	this->pendingScale = 1;
+}
+
+void Matrix::growRows(size_t capacity)
 {
-	this->matrix = new double *[rows];
-	for (size_t i = 0; i < rows; i++)
+	if (!this->ownsData)
+		throw std::logic_error("Matrix with borrowed storage cannot grow");
+	if (isInline())
+		spill();
+	if (!this->storage)
 	{
-		this->matrix[i] = new double[cols];
+		allocate(capacity, this->cols, false);
+		return;
 	}
+	double *block = allocateBlock((capacity - this->rowCapacity) * this->cols, false);
+	this->storage->blocks.push_back(block);
+	double **table = new double *[capacity];
+	this->storage->tables.push_back(table);
+	std::copy(this->matrix, this->matrix + this->rowCapacity, table);
+	for (size_t i = this->rowCapacity; i < capacity; i++)
+		table[i] = block + (i - this->rowCapacity) * this->cols;
+	this->matrix = table;
+	this->rowCapacity = capacity;
+}
+
+// amortised doubling for appends
+void Matrix::ensureRowCapacity(size_t needed)
+{
+	if (needed > this->rowCapacity)
+		growRows(std::max(needed, this->rowCapacity * 2));
+}
+
+/*
+
+ Constructors
+
+*/
+
+Matrix::Matrix(size_t rows, size_t cols)
+	: rows(rows), cols(cols), sum(0), sumComputed(false), pendingScale(1), shards(NULL), ownsData(true)
+{
+	allocate(rows, cols, true);
 	// std::cout << GREEN << "Matrix default constructor called" << DEFAULT << std::endl;
 }
 
 Matrix::Matrix(size_t rows, size_t cols, double initValue)
-	: rows(rows), cols(cols)
+	: rows(rows), cols(cols), sumComputed(false), pendingScale(1), shards(NULL), ownsData(true)
 {
 	this->sum = pow(initValue, 2) * rows * cols;
-	this->matrix = new double *[rows];
-	for (size_t i = 0; i < rows; i++)
-	{
-		this->matrix[i] = new double[cols];
-		for (size_t j = 0; j < cols; j++)
-			this->matrix[i][j] = initValue;
-	}
+	allocate(rows, cols, false);
+	fillRows(this->matrix, rows, cols, initValue);
 	// std::cout << GREEN << "Matrix parameterized constructor called" << DEFAULT << std::endl;
 }
 
+// empty owning matrix, storage is allocated by the caller
+Matrix::Matrix()
+	: matrix(NULL), rows(0), cols(0), rowCapacity(0), sum(0), sumComputed(false), pendingScale(1), shards(NULL),
+	ownsData(true)
+{
+}
+
 Matrix::Matrix(const Matrix &other)
+	: Matrix()
 {
 	(*this) = other;
 	// std::cout << GREEN << "Matrix copy constructor called" << DEFAULT << std::endl;
 }
 
+/*
+
+	Materialization
+
+	The destination is left uninitialised and filled by one bulk copy per
+	row, split across the thread pool. When the storage of the rows is
+	given and tracks untouched groups, the destination comes from zero
+	pages instead and only the row runs that may hold non-zeros are
+	copied, as in the copy assignment.
+
+*/
+
+Matrix Matrix::fromRows(double **data, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+	const MatrixStorage *written)
+{
+	Matrix result;
+	result.rows = numRows;
+	result.cols = numCols;
+	if (written == NULL || written->trackedRows == 0)
+	{
+		result.allocate(numRows, numCols, false);
+		copyTile(result.matrix, data, startRow, startCol, numRows, numCols, true);
+		return result;
+	}
+	result.allocate(numRows, numCols, true);
+	written->forEachWritten(startRow, startRow + numRows, [&](size_t lo, size_t hi) {
+		copyTile(result.matrix + (lo - startRow), data, lo, startCol, hi - lo, numCols, true);
+		result.markWritten(lo - startRow, hi - lo);
+	});
+	return result;
+}
+
+/*
+
+	Borrowed storage
+
+	The matrix reads and writes the given rows but never frees them.
+	Copies of a wrapped matrix are regular owning matrices.
+
+*/
+
+Matrix::Matrix(double **data, size_t rows, size_t cols)
+	: matrix(data), rows(rows), cols(cols), rowCapacity(rows), sum(0), sumComputed(false), pendingScale(1), shards(NULL),
+	ownsData(false)
+{
+}
+
+Matrix Matrix::wrap(double **data, size_t rows, size_t cols)
+{
+	return Matrix(data, rows, cols);
+}
+
 /*
 
 	Asignment Operator
@@ -50,38 +273,86 @@ Matrix &Matrix::operator=(const Matrix &other)
 {
 	if (this != &other)
 	{
+		// same width and enough rows: copy over the current storage
+		bool fresh = !this->ownsData || this->matrix == NULL || this->cols != other.cols || this->rowCapacity < other.rows;
+		const MatrixStorage *source = other.storage.get();
 		this->rows = other.rows;
-		this->cols = other.cols;
-		this->matrix = new double *[other.rows];
-		for (size_t i = 0; i < other.rows; i++)
+		if (fresh && source != NULL && source->trackedRows > 0)
 		{
-			this->matrix[i] = new double[other.cols];
-			for (size_t j = 0; j < other.cols; j++)
-				this->matrix[i][j] = other.matrix[i][j];
+			// zero pages for the untouched groups, only the written rows are copied
+			release();
+			this->ownsData = true;
+			this->cols = other.cols;
+			allocate(other.rows, other.cols, true);
+			source->forEachWritten(0, other.rows, [this, &other](size_t lo, size_t hi) {
+				copyTile(this->matrix + lo, other.matrix, lo, 0, hi - lo, this->cols, true);
+				markWritten(lo, hi - lo);
+			});
 		}
+		else
+		{
+			if (fresh)
+			{
+				release();
+				this->ownsData = true;
+				this->cols = other.cols;
+				allocate(other.rows, other.cols, false);
+			}
+			copyRows(this->matrix, other.matrix, other.rows, other.cols, fresh);
+			markWritten(0, other.rows);
+		}
+		setSum(other.getSum());
+		this->sumComputed = other.sumComputed;
+		// the rows were copied as stored, the factor comes with them
+		this->pendingScale = other.pendingScale;
+		if (!canDeferScale())
+			materialize();
 	}
 	// std::cout << GREEN << "Matrix copy assignment operator called" << DEFAULT << std::endl;
 	return (*this);
 }
 
-Matrix::Matrix(Matrix &&other)
-	: rows(other.rows), cols(other.cols), matrix(std::move(other.matrix))
+Matrix::Matrix(Matrix &&other) noexcept
+	: matrix(other.matrix), rows(other.rows), cols(other.cols), rowCapacity(other.rowCapacity),
+	sum(other.sum), sumComputed(other.sumComputed), pendingScale(other.pendingScale), shards(other.shards),
+	storage(std::move(other.storage)), ownsData(other.ownsData)
 {
+	if (other.isInline())
+		takeInline(other);
+	other.matrix = NULL;
 	other.rows = 0;
 	other.cols = 0;
+	other.rowCapacity = 0;
+	other.pendingScale = 1;
+	other.shards = NULL;
 	// std::cout << GREEN << "Matrix move constructor called" << DEFAULT << std::endl;
 }
 
-Matrix &Matrix::operator=(Matrix &&other)
+Matrix &Matrix::operator=(Matrix &&other) noexcept
 {
 	if (this != &other)
 	{
+		release();
 		this->rows = other.rows;
 		this->cols = other.cols;
-		this->matrix = std::move(other.matrix);
-
+		this->rowCapacity = other.rowCapacity;
+		this->matrix = other.matrix;
+		this->storage = std::move(other.storage);
+		delete this->shards;
+		this->shards = other.shards;
+		this->sum = other.sum;
+		this->sumComputed = other.sumComputed;
+		this->pendingScale = other.pendingScale;
+		this->ownsData = other.ownsData;
+		if (other.isInline())
+			takeInline(other);
+
+		other.matrix = NULL;
 		other.rows = 0;
 		other.cols = 0;
+		other.rowCapacity = 0;
+		other.pendingScale = 1;
+		other.shards = NULL;
 	}
 	// std::cout << GREEN << "Matrix move assignment operator called" << DEFAULT << std::endl;
 	return *this;
@@ -89,18 +360,190 @@ Matrix &Matrix::operator=(Matrix &&other)
 
 Matrix::~Matrix()
 {
-	if (this->matrix != NULL)
+	release();
+	delete this->shards;
+	// std::cout << RED << "Matrix destructor called" << DEFAULT << std::endl;
+}
+
+void Matrix::swap(Matrix &other) noexcept
+{
+	if (this == &other)
+		return;
+	Matrix tmp(std::move(other));
+	other = std::move(*this);
+	*this = std::move(tmp);
+}
+
+/*
+
+	Growth
+
+	Appended rows are added to the cached sum of squares as they arrive,
+	dropped rows and columns are subtracted, so a computed norm stays O(1).
+	Growing past the row capacity reallocates only the row pointer table:
+	existing rows stay where they are, and views created before the growth
+	keep reading them through the old table.
+
+*/
+
+void Matrix::reserveRows(size_t capacity)
+{
+	if (capacity > this->rowCapacity)
+		growRows(capacity);
+}
+
+void Matrix::appendRow(const double *values)
+{
+	materialize();
+	ensureRowCapacity(this->rows + 1);
+	std::copy(values, values + this->cols, this->matrix[this->rows]);
+	markWritten(this->rows, 1);
+	addToSum(sumOfSquares(this->matrix[this->rows], this->cols));
+	this->rows++;
+}
+
+void Matrix::appendRow(const std::vector<double> &values)
+{
+	if (values.size() != this->cols)
+		throw std::invalid_argument("appendRow: row length does not match the matrix");
+	appendRow(values.data());
+}
+
+void Matrix::appendRows(const MatrixView &block)
+{
+	if (block.getCols() != this->cols)
+		throw std::invalid_argument("appendRows: block width does not match the matrix");
+	materialize();
+	size_t n = block.getRows();
+	// taken before growing, the block may be a view of this matrix
+	std::vector<double *> src(n);
+	for (size_t i = 0; i < n; i++)
+		src[i] = block.matrix_ptr[block.getStartRow() + i] + block.getStartCol();
+	ensureRowCapacity(this->rows + n);
+	copyRows(this->matrix + this->rows, src.data(), n, this->cols);
+	markWritten(this->rows, n);
+	addToSum(sumOfSquares(this->matrix, this->rows, 0, n, this->cols));
+	this->rows += n;
+}
+
+/*
+	block is read as stored, its pending scale is applied to the copied
+	rows only. After materialize() a block that is this matrix has none.
+*/
+void Matrix::appendRows(const Matrix &block)
+{
+	if (block.getCols() != this->cols)
+		throw std::invalid_argument("appendRows: block width does not match the matrix");
+	materialize();
+	size_t n = block.getRows();
+	double factor = block.getPendingScale();
+	// taken before growing, block may be this matrix
+	std::vector<double *> src(block.getRawMatrix(), block.getRawMatrix() + n);
+	ensureRowCapacity(this->rows + n);
+	copyRows(this->matrix + this->rows, src.data(), n, this->cols);
+	if (factor != 1)
+		scaleTile(this->matrix, this->rows, 0, n, this->cols, factor);
+	markWritten(this->rows, n);
+	addToSum(sumOfSquares(this->matrix, this->rows, 0, n, this->cols));
+	this->rows += n;
+}
+
+/*
+	New elements are zero. Changing the row count keeps every row in place;
+	changing the column count has to copy each row into new storage.
+*/
+void Matrix::resize(size_t newRows, size_t newCols)
+{
+	if (!this->ownsData && (newRows > this->rowCapacity || newCols != this->cols))
+		throw std::logic_error("Matrix with borrowed storage cannot grow");
+	materialize();
+	if (newRows < this->rows)
+	{
+		addToSum(-sumOfSquares(this->matrix, newRows, 0, this->rows - newRows, this->cols));
+		this->rows = newRows;
+	}
+	if (newCols != this->cols)
 	{
+		size_t keep = std::min(this->cols, newCols);
+		if (newCols < this->cols)
+			addToSum(-sumOfSquares(this->matrix, 0, newCols, this->rows, this->cols - newCols));
+		if (isInline())
+			spill();
+		double **old = this->matrix;
+		// keeps the old rows alive until they are copied
+		std::shared_ptr<MatrixStorage> oldStorage = this->storage;
+		allocate(std::max(this->rows, newRows), newCols, true);
 		for (size_t i = 0; i < this->rows; i++)
-		{
-			if (this->matrix[i] != NULL)
-			{
-				delete[] this->matrix[i];
-			}
-		}
-		// delete[] this->matrix;
+			std::copy(old[i], old[i] + keep, this->matrix[i]);
+		markWritten(0, this->rows);
+		this->cols = newCols;
 	}
-	// std::cout << RED << "Matrix destructor called" << DEFAULT << std::endl;
+	if (newRows > this->rows)
+	{
+		ensureRowCapacity(newRows);
+		fillRows(this->matrix + this->rows, newRows - this->rows, this->cols, 0.0);
+		markWritten(this->rows, newRows - this->rows);
+		this->rows = newRows;
+	}
+}
+
+/*
+	Same elements, new shape. The data is reinterpreted where it lies when
+	it is one contiguous heap block, i.e. unless rows were appended past
+	the initial capacity or it came from a MatrixArena; otherwise it is
+	compacted into one block first.
+	Only the row pointer table is rebuilt. The sum of squares is unchanged.
+*/
+void Matrix::reshape(size_t newRows, size_t newCols)
+{
+	if (newRows * newCols != this->rows * this->cols)
+		throw std::invalid_argument("reshape: element count does not match");
+	if (newCols == this->cols)
+	{
+		this->rows = newRows;
+		return;
+	}
+	if (!this->ownsData)
+		throw std::logic_error("Matrix with borrowed storage cannot be reshaped");
+	if (newRows * newCols == 0)
+	{
+		release();
+		allocate(newRows, newCols, true);
+		this->rows = newRows;
+		this->cols = newCols;
+		return;
+	}
+	if (isInline())
+	{
+		for (size_t i = 0; i < newRows; i++)
+			this->inlineRows[i] = this->inlineData + i * newCols;
+		this->rowCapacity = newRows;
+		this->rows = newRows;
+		this->cols = newCols;
+		return;
+	}
+
+	bool contiguous = this->storage->blocks.size() == 1 && this->matrix[0] == this->storage->blocks[0];
+	size_t elements = this->rowCapacity * this->cols;
+	if (!contiguous)
+	{
+		double *block = allocateBlock(this->rows * this->cols, false);
+		for (size_t i = 0; i < this->rows; i++)
+			std::copy(this->matrix[i], this->matrix[i] + this->cols, block + i * this->cols);
+		this->storage = std::make_shared<MatrixStorage>();
+		this->storage->blocks.push_back(block);
+		elements = newRows * newCols;
+	}
+	// the zero groups were counted in rows of the old width
+	this->storage->untrack();
+
+	this->rowCapacity = elements / newCols;
+	this->matrix = new double *[this->rowCapacity];
+	this->storage->tables.push_back(this->matrix);
+	for (size_t i = 0; i < this->rowCapacity; i++)
+		this->matrix[i] = this->storage->blocks[0] + i * newCols;
+	this->rows = newRows;
+	this->cols = newCols;
 }
 
 /*
@@ -116,17 +559,68 @@ size_t Matrix::getCols() const
 	return this->cols;
 }
 
+size_t Matrix::getRowCapacity() const
+{
+	return this->rowCapacity;
+}
+
 double Matrix::getSum() const
 {
+	if (this->shards != NULL)
+		return this->sum + this->shards->total();
 	return this->sum;
 }
+/*
+	The caller may write anywhere without telling, so the storage stops
+	tracking untouched rows.
+*/
+double **Matrix::getMatrix()
+{
+	materialize();
+	if (this->storage)
+		this->storage->untrack();
+	return this->matrix;
+}
+
+/*
+	Reading a const Matrix never writes to it, so concurrent readers are
+	safe; a pending scale is left for the caller to apply.
+*/
 double **Matrix::getMatrix() const
 {
 	return this->matrix;
 }
+
+double **Matrix::getRawMatrix() const
+{
+	return this->matrix;
+}
+
+double Matrix::getPendingScale() const
+{
+	return this->pendingScale;
+}
+
+const std::shared_ptr<MatrixStorage> &Matrix::getStorage() const
+{
+	return this->storage;
+}
+
+const std::shared_ptr<MatrixStorage> &Matrix::shareStorage()
+{
+	materialize();
+	if (isInline())
+		spill();
+	return this->storage;
+}
+
+bool Matrix::isUntouched(size_t row) const
+{
+	return this->storage && this->storage->isUntouched(row);
+}
 double Matrix::getValue(size_t row, size_t col) const
 {
-	return this->matrix[row][col];
+	return this->matrix[row][col] * this->pendingScale;
 }
 bool Matrix::getSumComputed() const  {
 	return this->sumComputed;
@@ -160,19 +654,44 @@ void Matrix::setSumComputed(bool value)  {
 }
 
 void Matrix::set(size_t row, size_t col, double value) {
+	materialize();
+	markWritten(row, 1);
 	this->matrix[row][col] = value;
 }
 
 void Matrix::setValue(size_t row, size_t col, double value)
 {
+	materialize();
+	markWritten(row, 1);
 	this->matrix[row][col] = value;
 }
 
+void Matrix::markWritten(size_t firstRow, size_t numRows)
+{
+	if (this->storage)
+		this->storage->markWritten(firstRow, firstRow + numRows);
+}
+
 void Matrix::setSum(double value)
 {
+	if (this->shards != NULL)
+		this->shards->reset();
 	this->sum = value;
 }
 
+/*
+	Incremental update of the sum of squares.
+	In concurrent-write mode the delta goes to the calling thread's shard,
+	so parallel writers never touch the shared sum.
+*/
+void Matrix::addToSum(double delta)
+{
+	if (this->shards != NULL)
+		this->shards->add(delta);
+	else
+		this->sum += delta;
+}
+
 /*
 
 	Operator Overloading
@@ -188,6 +707,7 @@ MatrixView Matrix::operator()(size_t row, size_t col)
 	{
 		throw std::out_of_range("Index out of range");
 	}
+	materialize();
 	return MatrixView(*this, row, col);
 }
 
@@ -201,14 +721,14 @@ MatrixView Matrix::operator()(size_t row, size_t col)
 
 // double get(si)
 
-const double &Matrix::operator()(size_t row, size_t col) const
+double Matrix::operator()(size_t row, size_t col) const
 {
 	// std::cout << "const ElementProxy operator called" << std::endl;
 	if (row >= rows || col >= cols)
 	{
 		throw std::out_of_range("Index out of range");
 	}
-	return matrix[row][col];
+	return matrix[row][col] * pendingScale;
 }
 
 /*
@@ -216,7 +736,8 @@ const double &Matrix::operator()(size_t row, size_t col) const
 	Frobenius Norm
 
 	Compute the sum of the square of the matrix and return the square root of the sum
-	Complexity O(n^2) for the first call
+	The first call scans the rows on the shared thread pool, complexity O(n^2),
+	skipping the row groups still untouched since the zero allocation.
 	Then O(1) after.
 	The sum is update in each modifaction of the matrix so the Complexity stay O(1)
 
@@ -226,26 +747,123 @@ double Matrix::frobeniusNorm() const
 {
 	if (!sumComputed)
 	{
-		sum = 0;
-		for (size_t i = 0; i < this->rows; i++)
-		{
-			for (size_t j = 0; j < this->cols; j++)
-			{
-				sum += pow(this->matrix[i][j], 2);
-			}
-		}
+		if (shards != NULL)
+			shards->reset();
+		sum = this->storage ? this->storage->sumOfSquares(this->matrix, 0, 0, this->rows, this->cols)
+			: sumOfSquares(this->matrix, 0, 0, this->rows, this->cols);
+		sum *= pendingScale * pendingScale;
 		sumComputed = true;
 	}
+	if (shards != NULL)
+		return std::sqrt(sum + shards->total());
 	return std::sqrt(sum);
 }
 
+/*
+
+	Scaling
+
+	A pending factor is folded into the next factor and into the cached
+	sum, and is otherwise only read by getValue(), the norm and kernels
+	going through getRawMatrix(). Rows other code may be looking at (views,
+	borrowed rows, concurrent writers) are scaled on the spot instead.
+	The written rows are scaled in one pass that also yields their old
+	sum of squares, so the sum comes out exact either way.
+
+*/
+
+bool Matrix::canDeferScale() const
+{
+	return this->ownsData && this->shards == NULL && (!this->storage || this->storage.use_count() == 1);
+}
+
+// multiplies the stored rows by factor, returns their sum of squares from before
+double Matrix::scaleStored(double factor) const
+{
+	if (!this->storage)
+		return scaleTile(this->matrix, 0, 0, this->rows, this->cols, factor);
+	double total = 0;
+	this->storage->forEachWritten(0, this->rows, [&](size_t lo, size_t hi) {
+		total += scaleTile(this->matrix, lo, 0, hi - lo, this->cols, factor);
+	});
+	return total;
+}
+
+void Matrix::materialize()
+{
+	if (this->pendingScale == 1)
+		return;
+	double factor = this->pendingScale;
+	this->pendingScale = 1;
+	double before = scaleStored(factor);
+	if (!this->sumComputed)
+	{
+		if (this->shards != NULL)
+			this->shards->reset();
+		this->sum = before * factor * factor;
+		this->sumComputed = true;
+	}
+}
+
+void Matrix::scale(double factor)
+{
+	double pending = this->pendingScale * factor;
+	if (canDeferScale() && std::isfinite(pending) && pending != 0
+		&& std::abs(std::ilogb(pending)) <= 256)
+	{
+		this->pendingScale = pending;
+		this->sum *= factor * factor;
+		return;
+	}
+	this->pendingScale = 1;
+	double before = scaleStored(pending);
+	setSum(before * pending * pending);
+	this->sumComputed = true;
+}
+
+/*
+
+	Concurrent writes
+
+	The base sum is made exact before the shards are installed, after that
+	each writer thread only adds its own deltas to its own shard.
+	The partials are combined in frobeniusNorm() / getSum() and folded back
+	into the base sum when the mode is disabled.
+
+*/
+
+void Matrix::enableConcurrentWrites(size_t shardCount)
+{
+	if (this->shards != NULL)
+		return;
+	if (shardCount == 0)
+		shardCount = std::max(1u, std::thread::hardware_concurrency());
+	materialize();
+	this->frobeniusNorm();
+	this->shards = new ShardedSum(shardCount);
+}
+
+void Matrix::disableConcurrentWrites()
+{
+	if (this->shards == NULL)
+		return;
+	this->sum += this->shards->total();
+	delete this->shards;
+	this->shards = NULL;
+}
+
+bool Matrix::isConcurrentWrites() const
+{
+	return this->shards != NULL;
+}
+
 std::ostream &operator<<(std::ostream &os, const Matrix &matrixObj)
 {
 	for (size_t i = 0; i < matrixObj.rows; i++)
 	{
 		for (size_t j = 0; j < matrixObj.cols; j++)
 		{
-			os << matrixObj.matrix[i][j] << " ";
+			os << matrixObj.matrix[i][j] * matrixObj.pendingScale << " ";
 		}
 		os << std::endl;
 	}
@@ -0,0 +1,173 @@
+#include "../include/MatrixArena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace {
+
+thread_local MatrixArena	*innermost = NULL;
+
+const size_t ALIGNMENT = 64;
+const size_t DEFAULT_CHUNK_BYTES = size_t(1) << 20;
+// at most this many idle default-size chunks are kept
+const size_t CACHED_CHUNKS = 16;
+
+struct ChunkCache {
+	std::mutex			mutex;
+	std::vector<char *>	chunks;
+
+	~ChunkCache()
+	{
+		for (size_t c = 0; c < chunks.size(); c++)
+			std::free(chunks[c]);
+	}
+};
+
+ChunkCache	cache;
+
+char *takeChunk(size_t size)
+{
+	if (size == DEFAULT_CHUNK_BYTES)
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		if (!cache.chunks.empty())
+		{
+			char *chunk = cache.chunks.back();
+			cache.chunks.pop_back();
+			return chunk;
+		}
+	}
+	char *chunk = static_cast<char *>(std::malloc(size));
+	if (chunk == NULL)
+		throw std::bad_alloc();
+	return chunk;
+}
+
+void giveChunk(char *chunk, size_t size)
+{
+	if (size == DEFAULT_CHUNK_BYTES)
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		if (cache.chunks.size() < CACHED_CHUNKS)
+		{
+			cache.chunks.push_back(chunk);
+			return;
+		}
+	}
+	std::free(chunk);
+}
+
+}
+
+/*
+
+	Pool
+
+	Chunks are malloc'd, so their alignment is fixed up on the first
+	allocation from each. A request larger than a chunk gets a chunk of
+	its own and leaves the current one open.
+
+*/
+
+ArenaPool::ArenaPool(size_t chunkBytes)
+	: chunkBytes(std::max(chunkBytes, ALIGNMENT * 2)), next(NULL), left(0), used(0), references(1)
+{
+}
+
+ArenaPool::~ArenaPool()
+{
+	for (size_t c = 0; c < chunks.size(); c++)
+		giveChunk(chunks[c], sizes[c]);
+}
+
+void ArenaPool::retain()
+{
+	this->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ArenaPool::release()
+{
+	if (this->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete this;
+}
+
+void *ArenaPool::allocate(size_t bytes, bool zero)
+{
+	bytes = (std::max<size_t>(bytes, 1) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	char *result;
+	if (bytes <= this->left)
+	{
+		result = this->next;
+		this->next += bytes;
+		this->left -= bytes;
+	}
+	else
+	{
+		bool own = bytes + ALIGNMENT > this->chunkBytes;
+		size_t size = own ? bytes + ALIGNMENT : this->chunkBytes;
+		char *chunk = takeChunk(size);
+		this->chunks.push_back(chunk);
+		this->sizes.push_back(size);
+		result = chunk + (ALIGNMENT - reinterpret_cast<uintptr_t>(chunk) % ALIGNMENT) % ALIGNMENT;
+		if (!own)
+		{
+			this->next = result + bytes;
+			this->left = size - (this->next - chunk);
+		}
+	}
+	this->used += bytes;
+	if (zero)
+		std::memset(result, 0, bytes);
+	return result;
+}
+
+size_t ArenaPool::getUsed() const
+{
+	return this->used;
+}
+
+size_t ArenaPool::getChunks() const
+{
+	return this->chunks.size();
+}
+
+/*
+
+	Scope
+
+*/
+
+MatrixArena::MatrixArena(size_t chunkBytes)
+	: pool(new ArenaPool(chunkBytes)), previous(innermost)
+{
+	innermost = this;
+}
+
+MatrixArena::~MatrixArena()
+{
+	innermost = this->previous;
+	this->pool->release();
+}
+
+MatrixArena *MatrixArena::current()
+{
+	return innermost;
+}
+
+ArenaPool *MatrixArena::getPool() const
+{
+	return this->pool;
+}
+
+void *MatrixArena::allocate(size_t bytes, bool zero)
+{
+	return this->pool->allocate(bytes, zero);
+}
+
+size_t MatrixArena::getUsed() const
+{
+	return this->pool->getUsed();
+}
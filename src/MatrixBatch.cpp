@@ -0,0 +1,236 @@
+#include "../include/MatrixBatch.hpp"
+#include "../include/ThreadPool.hpp"
+#include <cmath>
+#include <stdexcept>
+
+/*
+
+	Batch
+
+*/
+
+MatrixBatch::MatrixBatch(size_t count, size_t rows, size_t cols, double initValue)
+	: count(count), rows(rows), cols(cols),
+	data(((count + LANES - 1) / LANES) * rows * cols * LANES, 0.0)
+{
+	if (initValue != 0.0)
+		fill(initValue);
+}
+
+size_t MatrixBatch::getCount() const
+{
+	return this->count;
+}
+
+size_t MatrixBatch::getRows() const
+{
+	return this->rows;
+}
+
+size_t MatrixBatch::getCols() const
+{
+	return this->cols;
+}
+
+size_t MatrixBatch::getGroups() const
+{
+	return (this->count + LANES - 1) / LANES;
+}
+
+double *MatrixBatch::elementPtr(size_t index, size_t row, size_t col)
+{
+	size_t group = index / LANES;
+	return this->data.data() + ((group * this->rows + row) * this->cols + col) * LANES + index % LANES;
+}
+
+const double *MatrixBatch::elementPtr(size_t index, size_t row, size_t col) const
+{
+	return const_cast<MatrixBatch *>(this)->elementPtr(index, row, col);
+}
+
+BatchMember MatrixBatch::member(size_t index)
+{
+	if (index >= this->count)
+		throw std::out_of_range("MatrixBatch member index out of range");
+	return BatchMember(*this, index);
+}
+
+/*
+
+	Batched kernels
+
+	The inner loops run over the LANES matrices of a group with a fixed
+	trip count, which the compiler turns into straight vector code.
+
+*/
+
+void MatrixBatch::frobeniusNorms(double *norms) const
+{
+	const double *base = this->data.data();
+	size_t elements = this->rows * this->cols;
+	size_t count = this->count;
+	ThreadPool::instance().parallelFor(0, getGroups(), elements * LANES, [=](size_t lo, size_t hi) {
+		for (size_t g = lo; g < hi; g++)
+		{
+			const double *group = base + g * elements * LANES;
+			double acc[LANES] = {};
+			for (size_t e = 0; e < elements; e++)
+				for (size_t l = 0; l < LANES; l++)
+					acc[l] += group[e * LANES + l] * group[e * LANES + l];
+			for (size_t l = 0; l < LANES && g * LANES + l < count; l++)
+				norms[g * LANES + l] = std::sqrt(acc[l]);
+		}
+	});
+}
+
+std::vector<double> MatrixBatch::frobeniusNorms() const
+{
+	std::vector<double> norms(this->count);
+	frobeniusNorms(norms.data());
+	return norms;
+}
+
+namespace {
+
+void checkShape(const MatrixBatch &a, const MatrixBatch &b)
+{
+	if (a.getCount() != b.getCount() || a.getRows() != b.getRows() || a.getCols() != b.getCols())
+		throw std::invalid_argument("MatrixBatch shapes do not match");
+}
+
+// both batches share the layout, so element-wise is one flat loop
+template <typename F>
+void forEachElement(double *dst, const double *src, size_t n, F f)
+{
+	ThreadPool::instance().parallelFor(0, n, 1, [=](size_t lo, size_t hi) {
+		for (size_t j = lo; j < hi; j++)
+			dst[j] = f(dst[j], src[j]);
+	});
+}
+
+}
+
+// padding lanes stay zero
+void MatrixBatch::fill(double value)
+{
+	for (size_t g = 0; g < getGroups(); g++)
+	{
+		size_t live = this->count - g * LANES;
+		double *group = this->data.data() + g * this->rows * this->cols * LANES;
+		for (size_t e = 0; e < this->rows * this->cols; e++)
+			for (size_t l = 0; l < LANES; l++)
+				group[e * LANES + l] = l < live ? value : 0.0;
+	}
+}
+
+void MatrixBatch::scale(double alpha)
+{
+	double *x = this->data.data();
+	ThreadPool::instance().parallelFor(0, this->data.size(), 1, [=](size_t lo, size_t hi) {
+		for (size_t j = lo; j < hi; j++)
+			x[j] *= alpha;
+	});
+}
+
+void MatrixBatch::axpy(double alpha, const MatrixBatch &other)
+{
+	checkShape(*this, other);
+	forEachElement(this->data.data(), other.data.data(), this->data.size(),
+		[alpha](double y, double x) { return y + alpha * x; });
+}
+
+void MatrixBatch::add(const MatrixBatch &other)
+{
+	checkShape(*this, other);
+	forEachElement(this->data.data(), other.data.data(), this->data.size(),
+		[](double y, double x) { return y + x; });
+}
+
+void MatrixBatch::hadamard(const MatrixBatch &other)
+{
+	checkShape(*this, other);
+	forEachElement(this->data.data(), other.data.data(), this->data.size(),
+		[](double y, double x) { return y * x; });
+}
+
+/*
+
+	Member
+
+*/
+
+BatchMember::BatchMember(MatrixBatch &batch, size_t index)
+	: batch(&batch), index(index)
+{
+}
+
+size_t BatchMember::getIndex() const
+{
+	return this->index;
+}
+
+size_t BatchMember::getRows() const
+{
+	return this->batch->getRows();
+}
+
+size_t BatchMember::getCols() const
+{
+	return this->batch->getCols();
+}
+
+double &BatchMember::operator()(size_t row, size_t col)
+{
+	return *this->batch->elementPtr(this->index, row, col);
+}
+
+const double &BatchMember::operator()(size_t row, size_t col) const
+{
+	return *this->batch->elementPtr(this->index, row, col);
+}
+
+double BatchMember::getValue(size_t row, size_t col) const
+{
+	if (row >= getRows() || col >= getCols())
+		throw std::out_of_range("BatchMember indices are out of range");
+	return (*this)(row, col);
+}
+
+void BatchMember::setValue(size_t row, size_t col, double value)
+{
+	if (row >= getRows() || col >= getCols())
+		throw std::out_of_range("BatchMember indices are out of range");
+	(*this)(row, col) = value;
+}
+
+double BatchMember::frobeniusNorm() const
+{
+	const double *x = this->batch->elementPtr(this->index, 0, 0);
+	size_t elements = getRows() * getCols();
+	double sum = 0;
+	for (size_t e = 0; e < elements; e++)
+		sum += x[e * MatrixBatch::LANES] * x[e * MatrixBatch::LANES];
+	return std::sqrt(sum);
+}
+
+Matrix BatchMember::toMatrix() const
+{
+	Matrix result(getRows(), getCols());
+	double **dst = result.getRawMatrix();
+	for (size_t i = 0; i < getRows(); i++)
+		for (size_t j = 0; j < getCols(); j++)
+			dst[i][j] = (*this)(i, j);
+	result.markWritten(0, getRows());
+	return result;
+}
+
+void BatchMember::assign(const Matrix &source)
+{
+	if (source.getRows() != getRows() || source.getCols() != getCols())
+		throw std::invalid_argument("BatchMember::assign: shapes do not match");
+	double **src = source.getRawMatrix();
+	double scale = source.getPendingScale();
+	for (size_t i = 0; i < getRows(); i++)
+		for (size_t j = 0; j < getCols(); j++)
+			(*this)(i, j) = scale * src[i][j];
+}
@@ -1,6 +1,7 @@
 #include "../include/MatrixView.hpp"
 #include <cmath>
 #include "../include/Matrix.hpp"
+#include "../include/rowKernels.hpp"
 #include <stdexcept>
 
 /**
@@ -9,7 +10,7 @@
  * This constructor creates a view of a single element in the matrix.
  */
 MatrixView::MatrixView(Matrix &matrix, size_t row, size_t col)
-    : matrix(matrix), row(row), col(col), matrix_ptr(matrix.getMatrix()), sumComputed(false), sum(0), cols(1), rows(1), startRow(row), startCol(col)
+    : matrix(matrix), row(row), col(col), matrix_ptr(matrix.getRawMatrix()), sumComputed(false), sum(0), cols(1), rows(1), startRow(row), startCol(col)
 {
 }
 
@@ -22,7 +23,9 @@ MatrixView::MatrixView(Matrix &matrix, size_t row, size_t col)
 MatrixView::MatrixView(Matrix &matrix, size_t startRow, size_t startCol, size_t num_rows, size_t num_cols)
     : matrix(matrix), rows(num_rows), cols(num_cols), startRow(startRow), startCol(startCol)
 {
-    matrix_ptr = matrix.getMatrix();
+    // writes through the view are recorded with markWritten
+    storage = matrix.shareStorage();
+    matrix_ptr = matrix.getRawMatrix();
     row = 0;
     col = 0;
 
@@ -44,6 +47,7 @@ MatrixView::MatrixView(const MatrixView &other)
 {
     sumComputed = other.sumComputed;
     matrix_ptr = other.matrix_ptr;
+    storage = other.storage;
     sum = other.sum;
 }
 
@@ -62,6 +66,7 @@ MatrixView &MatrixView::operator=(const MatrixView &other)
         this->startRow = other.startRow;
         this->startCol = other.startCol;
         this->matrix_ptr = other.matrix_ptr;
+        this->storage = other.storage;
     }
     return (*this);
 }
@@ -74,7 +79,7 @@ MatrixView &MatrixView::operator=(const MatrixView &other)
 MatrixView &MatrixView::operator=(double value)
 {
     double d = matrix.getValue(row, col);
-    matrix.setSum(matrix.getSum() - pow(d, 2) + pow(value, 2));
+    matrix.addToSum(pow(value, 2) - pow(d, 2));
     sum = sum - pow(d, 2) + pow(value, 2);
     matrix.setValue(row, col, value);
     return *this;
@@ -89,6 +94,9 @@ MatrixView::MatrixView(MatrixView &&other)
     : matrix(other.matrix), rows(other.rows), cols(other.cols), startRow(other.startRow), startCol(other.startCol)
 {
     matrix_ptr = other.matrix_ptr;
+    storage = std::move(other.storage);
+    sum = other.sum;
+    sumComputed = other.sumComputed;
     other.sumComputed = false;
     other.matrix_ptr = nullptr;
     other.sum = 0;
@@ -112,6 +120,7 @@ MatrixView &MatrixView::operator=(MatrixView &&other)
         this->matrix = other.matrix;
         this->rows = other.rows;
         this->matrix_ptr = std::move(other.matrix_ptr);
+        this->storage = std::move(other.storage);
         this->cols = other.cols;
         this->startRow = other.startRow;
         this->startCol = other.startCol;
@@ -197,6 +206,8 @@ void MatrixView::updateValueAndSum(double value, size_t row, size_t col)
 {
     double d = matrix_ptr[row + startRow][col + startCol];
     sum = sum - pow(d, 2) + pow(value, 2);
+    if (storage)
+        storage->markWritten(row + startRow, row + startRow + 1);
     matrix_ptr[row + startRow][col + startCol] = value;
 }
 
@@ -207,6 +218,8 @@ void MatrixView::updateValueAndSum(double value, size_t row, size_t col)
  */
 void MatrixView::setValue(size_t row, size_t col, double value)
 {
+    if (storage)
+        storage->markWritten(row + startRow, row + startRow + 1);
     matrix_ptr[row + startRow][col + startCol] = value;
 }
 
@@ -214,20 +227,14 @@ void MatrixView::setValue(size_t row, size_t col, double value)
  * @brief Convert MatrixView to Matrix
  *
  * This operator creates a new Matrix object from the MatrixView.
+ * The rows of the tile are bulk-copied, skipping the parent's untouched
+ * row groups, and the cached sum carries over.
  */
 MatrixView::operator Matrix() const
 {
-    Matrix tmp(this->getRows(), this->getCols());
-    for (size_t i = 0; i < this->getRows(); ++i)
-    {
-        for (size_t j = 0; j < this->getCols(); ++j)
-        {
-            tmp(i, j) = (*this)(i, j);
-        }
-    }
-      // std::cout << tmp(2,3) << std::endl;
-        tmp.setSum((this)->sum);
-        tmp.setSumComputed(this->sumComputed);
+    Matrix tmp = Matrix::fromRows(matrix_ptr, startRow, startCol, rows, cols, storage.get());
+    tmp.setSum(this->sum);
+    tmp.setSumComputed(this->sumComputed);
     return tmp;
 }
 
@@ -245,6 +252,9 @@ MatrixView::operator double() const
  * @brief Calculate the Frobenius norm of the MatrixView
  *
  * This method calculates and returns the Frobenius norm of the MatrixView.
+ * The rows of the tile are scanned directly (no bounds-checked access) and
+ * split across the shared thread pool when the tile is large enough.
+ * Row groups of the parent that were never written are skipped.
  */
 
 
@@ -254,13 +264,32 @@ MatrixView::operator double() const
 
 double MatrixView::frobeniusNorm() const {
     if (!sumComputed) {
-        sum = 0;
-        for (int i = 0; i < rows; ++i) {
-                for (int j = 0; j < cols; ++j) {
-                    sum += std::pow((*this)(i, j), 2);
-                }
-            }
+        sum = storage ? storage->sumOfSquares(matrix_ptr, startRow, startCol, rows, cols)
+            : sumOfSquares(matrix_ptr, startRow, startCol, rows, cols);
         sumComputed = true;
     }
     return std::sqrt(sum);
-}
\ No newline at end of file
+}
+/**
+ * @brief Multiply every element of the MatrixView by a factor
+ *
+ * The rows are shared with the parent and its other views, so the factor
+ * cannot be kept aside as Matrix::scale does: the tile is scaled in place,
+ * skipping untouched row groups, in one pass that also returns its old sum
+ * of squares. The view's sum and the parent's cached sum are updated from
+ * that without a rescan.
+ */
+void MatrixView::scale(double factor)
+{
+    double before = 0;
+    if (storage)
+        storage->forEachWritten(startRow, startRow + rows, [&](size_t lo, size_t hi) {
+            before += scaleTile(matrix_ptr, lo, startCol, hi - lo, cols, factor);
+        });
+    else
+        before = scaleTile(matrix_ptr, startRow, startCol, rows, cols, factor);
+    double after = before * factor * factor;
+    sum = after;
+    sumComputed = true;
+    matrix.addToSum(after - before);
+}
@@ -0,0 +1,166 @@
+#include "../include/RingMatrix.hpp"
+#include "../include/rowKernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/*
+
+	Constructor
+
+*/
+
+RingMatrix::RingMatrix(size_t capacity, size_t cols)
+	: capacity(capacity), cols(cols), head(0), count(0), sinceRebase(0), data(capacity, cols),
+	table(2 * capacity), window(Matrix::wrap(table.data(), 2 * capacity, cols)),
+	cumulative(capacity, 0.0), evicted(0)
+{
+	if (capacity == 0)
+		throw std::invalid_argument("RingMatrix capacity must be positive");
+	double **rows = data.getMatrix();
+	for (size_t i = 0; i < capacity; i++)
+	{
+		table[i] = rows[i];
+		table[i + capacity] = rows[i];
+	}
+}
+
+/*
+
+	Getters
+
+*/
+
+size_t RingMatrix::getCapacity() const
+{
+	return this->capacity;
+}
+
+size_t RingMatrix::getRows() const
+{
+	return this->count;
+}
+
+size_t RingMatrix::getCols() const
+{
+	return this->cols;
+}
+
+bool RingMatrix::isFull() const
+{
+	return this->count == this->capacity;
+}
+
+size_t RingMatrix::physical(size_t row) const
+{
+	return (this->head + row) % this->capacity;
+}
+
+/*
+
+	Stream
+
+	The evicted row's squares leave the window through `evicted`, the new
+	row's enter through its running sum: O(cols) for the copy and the
+	squares, O(1) for the bookkeeping.
+
+*/
+
+void RingMatrix::push(const double *row)
+{
+	double previous = this->count > 0 ? this->cumulative[physical(this->count - 1)] : this->evicted;
+	size_t slot;
+	if (this->count < this->capacity)
+		slot = physical(this->count++);
+	else
+	{
+		slot = this->head;
+		this->evicted = this->cumulative[slot];
+		this->head = (this->head + 1) % this->capacity;
+	}
+	double *dst = this->table[slot];
+	std::copy(row, row + this->cols, dst);
+	this->data.markWritten(slot, 1);
+	this->cumulative[slot] = previous + sumOfSquares(dst, this->cols);
+	if (++this->sinceRebase >= this->capacity)
+		rebase();
+}
+
+void RingMatrix::push(const std::vector<double> &row)
+{
+	if (row.size() != this->cols)
+		throw std::invalid_argument("RingMatrix::push: row length does not match");
+	push(row.data());
+}
+
+void RingMatrix::clear()
+{
+	this->head = 0;
+	this->count = 0;
+	this->sinceRebase = 0;
+	this->evicted = 0;
+}
+
+// running sums restart from the oldest stored row
+void RingMatrix::rebase()
+{
+	for (size_t i = 0; i < this->count; i++)
+		this->cumulative[physical(i)] -= this->evicted;
+	this->evicted = 0;
+	this->sinceRebase = 0;
+}
+
+/*
+
+	Access
+
+*/
+
+double RingMatrix::getValue(size_t row, size_t col) const
+{
+	if (row >= this->count || col >= this->cols)
+		throw std::out_of_range("RingMatrix index out of range");
+	return this->table[physical(row)][col];
+}
+
+const double *RingMatrix::getRow(size_t row) const
+{
+	if (row >= this->count)
+		throw std::out_of_range("RingMatrix index out of range");
+	return this->table[physical(row)];
+}
+
+ConstMatrixView RingMatrix::view() const
+{
+	return view(0, 0, this->count, this->cols);
+}
+
+ConstMatrixView RingMatrix::view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+{
+	if (startRow + numRows > this->count || startCol + numCols > this->cols)
+		throw std::out_of_range("RingMatrix view exceeds the stored rows");
+	return ConstMatrixView(this->window, this->head + startRow, startCol, numRows, numCols);
+}
+
+/*
+
+	Norms
+
+*/
+
+double RingMatrix::frobeniusNorm() const
+{
+	return windowNorm(this->count);
+}
+
+double RingMatrix::windowNorm(size_t length) const
+{
+	if (length > this->count)
+		throw std::out_of_range("RingMatrix window longer than the stored rows");
+	if (length == 0)
+		return 0;
+	double newest = this->cumulative[physical(this->count - 1)];
+	double before = length == this->count ? this->evicted : this->cumulative[physical(this->count - length - 1)];
+	// the difference can round slightly below zero for an all-zero window
+	return std::sqrt(std::max(0.0, newest - before));
+}
@@ -0,0 +1,51 @@
+#include "../include/ShardedSum.hpp"
+#include "../include/ThreadSlot.hpp"
+
+ShardedSum::ShardedSum(size_t shardCount)
+	: shards(new Shard[shardCount + 1]), shardCount(shardCount)
+{
+	reset();
+}
+
+ShardedSum::~ShardedSum()
+{
+	delete[] shards;
+}
+
+size_t ShardedSum::getShardCount() const
+{
+	return shardCount;
+}
+
+/*
+	Only the owning thread writes an exclusive shard, so load + store is
+	enough there. The overflow shard (index shardCount) is contended.
+*/
+void ShardedSum::add(double delta)
+{
+	size_t slot = threadSlot();
+	if (slot < shardCount)
+	{
+		std::atomic<double> &v = shards[slot].value;
+		v.store(v.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+		return;
+	}
+	std::atomic<double> &v = shards[shardCount].value;
+	double expected = v.load(std::memory_order_relaxed);
+	while (!v.compare_exchange_weak(expected, expected + delta, std::memory_order_relaxed))
+		;
+}
+
+double ShardedSum::total() const
+{
+	double total = 0;
+	for (size_t i = 0; i <= shardCount; i++)
+		total += shards[i].value.load(std::memory_order_relaxed);
+	return total;
+}
+
+void ShardedSum::reset()
+{
+	for (size_t i = 0; i <= shardCount; i++)
+		shards[i].value.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,405 @@
+#include "../include/SparseMatrix.hpp"
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// average work behind one major line, for the pool's serial cutoff
+size_t lineCost(const SparseMatrix &m)
+{
+	return m.getNonZeros() / std::max<size_t>(1, m.getMajorSize()) + 1;
+}
+
+}
+
+/*
+
+	Constructors
+
+*/
+
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, Format format)
+	: rows(rows), cols(cols), format(format), sum(0)
+{
+	offsets.assign(getMajorSize() + 1, 0);
+}
+
+SparseMatrix::SparseMatrix(size_t rows, size_t cols, Format format, std::vector<size_t> offsets,
+	std::vector<size_t> indices, std::vector<double> values)
+	: rows(rows), cols(cols), format(format), offsets(std::move(offsets)), indices(std::move(indices)),
+	values(std::move(values)), sum(0)
+{
+	validate();
+	computeSum();
+}
+
+SparseMatrix::SparseMatrix(const Matrix &dense, Format format, double dropTolerance)
+	: rows(dense.getRows()), cols(dense.getCols()), format(CSR), sum(0)
+{
+	double **src = dense.getRawMatrix();
+	double scale = dense.getPendingScale();
+	offsets.reserve(rows + 1);
+	offsets.push_back(0);
+	for (size_t i = 0; i < rows; i++)
+	{
+		for (size_t j = 0; j < cols; j++)
+		{
+			double value = scale * src[i][j];
+			if (std::fabs(value) > dropTolerance)
+			{
+				indices.push_back(j);
+				values.push_back(value);
+			}
+		}
+		offsets.push_back(indices.size());
+	}
+	computeSum();
+	if (format == CSC)
+		*this = convert(CSC);
+}
+
+void SparseMatrix::validate() const
+{
+	size_t minor = format == CSR ? cols : rows;
+	if (offsets.size() != getMajorSize() + 1 || offsets.front() != 0)
+		throw std::invalid_argument("SparseMatrix offsets do not match the dimensions");
+	if (offsets.back() != indices.size() || indices.size() != values.size())
+		throw std::invalid_argument("SparseMatrix arrays have inconsistent sizes");
+	for (size_t k = 0; k < getMajorSize(); k++)
+	{
+		if (offsets[k] > offsets[k + 1])
+			throw std::invalid_argument("SparseMatrix offsets are not monotonic");
+		for (size_t p = offsets[k]; p < offsets[k + 1]; p++)
+			if (indices[p] >= minor || (p > offsets[k] && indices[p] <= indices[p - 1]))
+				throw std::invalid_argument("SparseMatrix indices are out of range or unsorted");
+	}
+}
+
+void SparseMatrix::computeSum()
+{
+	sum = 0;
+	for (size_t p = 0; p < values.size(); p++)
+		sum += values[p] * values[p];
+}
+
+/*
+
+	Getters
+
+*/
+
+size_t SparseMatrix::getRows() const
+{
+	return this->rows;
+}
+
+size_t SparseMatrix::getCols() const
+{
+	return this->cols;
+}
+
+SparseMatrix::Format SparseMatrix::getFormat() const
+{
+	return this->format;
+}
+
+size_t SparseMatrix::getNonZeros() const
+{
+	return this->values.size();
+}
+
+size_t SparseMatrix::getMajorSize() const
+{
+	return this->format == CSR ? this->rows : this->cols;
+}
+
+const std::vector<size_t> &SparseMatrix::getOffsets() const
+{
+	return this->offsets;
+}
+
+const std::vector<size_t> &SparseMatrix::getIndices() const
+{
+	return this->indices;
+}
+
+const std::vector<double> &SparseMatrix::getValues() const
+{
+	return this->values;
+}
+
+double SparseMatrix::getValue(size_t row, size_t col) const
+{
+	if (row >= rows || col >= cols)
+		throw std::out_of_range("SparseMatrix index out of range");
+	size_t major = format == CSR ? row : col;
+	size_t minor = format == CSR ? col : row;
+	std::vector<size_t>::const_iterator first = indices.begin() + offsets[major];
+	std::vector<size_t>::const_iterator last = indices.begin() + offsets[major + 1];
+	std::vector<size_t>::const_iterator it = std::lower_bound(first, last, minor);
+	if (it == last || *it != minor)
+		return 0;
+	return values[it - indices.begin()];
+}
+
+/*
+
+	Conversions
+
+	CSR <-> CSC is a counting sort of the entries by minor index; walking
+	the source lines in order keeps the new minor indices sorted.
+
+*/
+
+SparseMatrix SparseMatrix::convert(Format target) const
+{
+	if (target == format)
+		return *this;
+	size_t newMajor = format == CSR ? cols : rows;
+	std::vector<size_t> newOffsets(newMajor + 1, 0);
+	for (size_t p = 0; p < indices.size(); p++)
+		newOffsets[indices[p] + 1]++;
+	for (size_t k = 0; k < newMajor; k++)
+		newOffsets[k + 1] += newOffsets[k];
+
+	std::vector<size_t> newIndices(indices.size());
+	std::vector<double> newValues(values.size());
+	std::vector<size_t> next(newOffsets.begin(), newOffsets.end() - 1);
+	for (size_t k = 0; k < getMajorSize(); k++)
+		for (size_t p = offsets[k]; p < offsets[k + 1]; p++)
+		{
+			size_t q = next[indices[p]]++;
+			newIndices[q] = k;
+			newValues[q] = values[p];
+		}
+
+	SparseMatrix result(rows, cols, target);
+	result.offsets.swap(newOffsets);
+	result.indices.swap(newIndices);
+	result.values.swap(newValues);
+	result.sum = sum;
+	return result;
+}
+
+Matrix SparseMatrix::toDense() const
+{
+	return view(0, 0, rows, cols).toDense();
+}
+
+double SparseMatrix::frobeniusNorm() const
+{
+	return std::sqrt(sum);
+}
+
+SparseMatrixView SparseMatrix::view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+{
+	return SparseMatrixView(*this, startRow, startCol, numRows, numCols);
+}
+
+/*
+
+	SparseMatrixView
+
+*/
+
+SparseMatrixView::SparseMatrixView(const SparseMatrix &matrix, size_t startRow, size_t startCol,
+	size_t numRows, size_t numCols)
+	: matrix(matrix), rows(numRows), cols(numCols), startRow(startRow), startCol(startCol),
+	sum(0), sumComputed(false)
+{
+	if (startRow + rows > matrix.getRows() || startCol + cols > matrix.getCols())
+		throw std::out_of_range("SparseMatrixView dimensions exceed matrix bounds");
+}
+
+const SparseMatrix &SparseMatrixView::getMatrix() const
+{
+	return this->matrix;
+}
+
+size_t SparseMatrixView::getRows() const
+{
+	return this->rows;
+}
+
+size_t SparseMatrixView::getCols() const
+{
+	return this->cols;
+}
+
+size_t SparseMatrixView::getStartRow() const
+{
+	return this->startRow;
+}
+
+size_t SparseMatrixView::getStartCol() const
+{
+	return this->startCol;
+}
+
+void SparseMatrixView::lineRange(size_t k, size_t &first, size_t &last) const
+{
+	const std::vector<size_t> &indices = matrix.getIndices();
+	const std::vector<size_t> &offsets = matrix.getOffsets();
+	bool csr = matrix.getFormat() == SparseMatrix::CSR;
+	size_t lo = csr ? startCol : startRow;
+	size_t hi = lo + (csr ? cols : rows);
+
+	std::vector<size_t>::const_iterator begin = indices.begin() + offsets[k];
+	std::vector<size_t>::const_iterator end = indices.begin() + offsets[k + 1];
+	// a tile covering the whole line needs no search
+	if (lo != 0)
+		begin = std::lower_bound(begin, end, lo);
+	if (hi != (csr ? matrix.getCols() : matrix.getRows()))
+		end = std::lower_bound(begin, end, hi);
+	first = begin - indices.begin();
+	last = end - indices.begin();
+}
+
+double SparseMatrixView::getValue(size_t row, size_t col) const
+{
+	if (row >= rows || col >= cols)
+		throw std::out_of_range("SparseMatrixView index out of range");
+	return matrix.getValue(startRow + row, startCol + col);
+}
+
+size_t SparseMatrixView::getNonZeros() const
+{
+	bool csr = matrix.getFormat() == SparseMatrix::CSR;
+	size_t major = csr ? startRow : startCol;
+	size_t count = 0;
+	for (size_t k = major; k < major + (csr ? rows : cols); k++)
+	{
+		size_t first, last;
+		lineRange(k, first, last);
+		count += last - first;
+	}
+	return count;
+}
+
+double SparseMatrixView::frobeniusNorm() const
+{
+	if (!sumComputed)
+	{
+		bool csr = matrix.getFormat() == SparseMatrix::CSR;
+		size_t major = csr ? startRow : startCol;
+		const std::vector<double> &values = matrix.getValues();
+		sum = ThreadPool::instance().parallelReduce(major, major + (csr ? rows : cols), lineCost(matrix), 0.0,
+			[&](size_t lo, size_t hi) {
+				double s = 0;
+				for (size_t k = lo; k < hi; k++)
+				{
+					size_t first, last;
+					lineRange(k, first, last);
+					for (size_t p = first; p < last; p++)
+						s += values[p] * values[p];
+				}
+				return s;
+			},
+			[](double a, double b) { return a + b; });
+		sumComputed = true;
+	}
+	return std::sqrt(sum);
+}
+
+Matrix SparseMatrixView::toDense() const
+{
+	Matrix result(rows, cols);
+	double **dst = result.getRawMatrix();
+	bool csr = matrix.getFormat() == SparseMatrix::CSR;
+	size_t major = csr ? startRow : startCol;
+	const std::vector<size_t> &indices = matrix.getIndices();
+	const std::vector<double> &values = matrix.getValues();
+	double s = 0;
+	for (size_t k = major; k < major + (csr ? rows : cols); k++)
+	{
+		size_t first, last;
+		lineRange(k, first, last);
+		if (csr && first < last)
+			result.markWritten(k - startRow, 1);
+		for (size_t p = first; p < last; p++)
+		{
+			if (csr)
+				dst[k - startRow][indices[p] - startCol] = values[p];
+			else
+			{
+				dst[indices[p] - startRow][k - startCol] = values[p];
+				result.markWritten(indices[p] - startRow, 1);
+			}
+			s += values[p] * values[p];
+		}
+	}
+	result.setSum(s);
+	result.setSumComputed(true);
+	return result;
+}
+
+/*
+
+	SpMV
+
+*/
+
+void spmv(const SparseMatrixView &a, const double *x, double *y, double alpha, double beta)
+{
+	const SparseMatrix &m = a.getMatrix();
+	const std::vector<size_t> &indices = m.getIndices();
+	const std::vector<double> &values = m.getValues();
+	size_t rows = a.getRows(), cols = a.getCols();
+	size_t startRow = a.getStartRow(), startCol = a.getStartCol();
+	ThreadPool &pool = ThreadPool::instance();
+
+	if (m.getFormat() == SparseMatrix::CSR)
+	{
+		pool.parallelFor(0, rows, lineCost(m), [&](size_t lo, size_t hi) {
+			for (size_t i = lo; i < hi; i++)
+			{
+				size_t first, last;
+				a.lineRange(startRow + i, first, last);
+				double d = 0;
+				for (size_t p = first; p < last; p++)
+					d += values[p] * x[indices[p] - startCol];
+				y[i] = beta == 0 ? alpha * d : alpha * d + beta * y[i];
+			}
+		});
+		return;
+	}
+
+	const std::vector<size_t> &offsets = m.getOffsets();
+	pool.parallelFor(0, rows, (m.getNonZeros() + cols) / std::max<size_t>(1, m.getRows()) + 1,
+		[&](size_t lo, size_t hi) {
+			if (beta == 0)
+				std::fill(y + lo, y + hi, 0.0);
+			else if (beta != 1)
+				for (size_t i = lo; i < hi; i++)
+					y[i] *= beta;
+			for (size_t c = 0; c < cols; c++)
+			{
+				std::vector<size_t>::const_iterator begin = indices.begin() + offsets[startCol + c];
+				std::vector<size_t>::const_iterator end = indices.begin() + offsets[startCol + c + 1];
+				begin = std::lower_bound(begin, end, startRow + lo);
+				double ax = alpha * x[c];
+				for (; begin != end && *begin < startRow + hi; ++begin)
+					y[*begin - startRow] += ax * values[begin - indices.begin()];
+			}
+		});
+}
+
+void spmv(const SparseMatrixView &a, const std::vector<double> &x, std::vector<double> &y,
+	double alpha, double beta)
+{
+	if (x.size() != a.getCols())
+		throw std::invalid_argument("spmv: x has the wrong size");
+	if (beta == 0)
+		y.resize(a.getRows());
+	else if (y.size() != a.getRows())
+		throw std::invalid_argument("spmv: y has the wrong size");
+	spmv(a, x.data(), y.data(), alpha, beta);
+}
+
+void spmv(const SparseMatrix &a, const std::vector<double> &x, std::vector<double> &y,
+	double alpha, double beta)
+{
+	spmv(a.view(0, 0, a.getRows(), a.getCols()), x, y, alpha, beta);
+}
@@ -0,0 +1,307 @@
+#include "../include/ThreadPool.hpp"
+#include <cstdlib>
+#include <string>
+#include <utility>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// index of the current worker in its pool, only valid when currentPool matches
+thread_local const ThreadPool	*currentPool = NULL;
+thread_local size_t				currentIndex = 0;
+
+size_t envSize(const char *name, size_t fallback)
+{
+	const char *value = std::getenv(name);
+	if (value == NULL || *value == '\0')
+		return fallback;
+	try
+	{
+		return static_cast<size_t>(std::stoull(value));
+	}
+	catch (const std::exception &)
+	{
+		return fallback;
+	}
+}
+
+}
+
+/*
+
+	Configuration
+
+*/
+
+ThreadPool::Config::Config()
+	: threads(std::max(1u, std::thread::hardware_concurrency())), pinThreads(false),
+	spinIterations(2000), serialCutoff(1 << 15)
+{
+}
+
+ThreadPool::Config ThreadPool::Config::fromEnvironment()
+{
+	Config config;
+	config.threads = std::max<size_t>(1, envSize("MATRIX_THREADS", config.threads));
+	config.pinThreads = envSize("MATRIX_PIN_THREADS", 0) != 0;
+	config.spinIterations = envSize("MATRIX_SPIN", config.spinIterations);
+	config.serialCutoff = envSize("MATRIX_SERIAL_CUTOFF", config.serialCutoff);
+	return config;
+}
+
+/*
+
+	Constructors
+
+*/
+
+ThreadPool::ThreadPool(size_t threadCount)
+	: pending(0), queued(0), sleeping(0), stopping(false)
+{
+	config.threads = std::max<size_t>(1, threadCount);
+	start();
+}
+
+ThreadPool::ThreadPool(const Config &config)
+	: config(config), pending(0), queued(0), sleeping(0), stopping(false)
+{
+	this->config.threads = std::max<size_t>(1, config.threads);
+	start();
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+ThreadPool &ThreadPool::instance()
+{
+	static ThreadPool pool(Config::fromEnvironment());
+	return pool;
+}
+
+void ThreadPool::start()
+{
+	stopping = false;
+	for (size_t i = 0; i < config.threads; i++)
+		workers.push_back(new Worker());
+	for (size_t i = 0; i < config.threads; i++)
+	{
+		threads.emplace_back(&ThreadPool::workerLoop, this, i);
+#ifdef __linux__
+		if (config.pinThreads)
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(i % std::max(1u, std::thread::hardware_concurrency()), &set);
+			pthread_setaffinity_np(threads[i].native_handle(), sizeof(set), &set);
+		}
+#endif
+	}
+}
+
+/*
+	Queued tasks are finished before the workers exit. An exception nobody
+	waited for is dropped.
+*/
+void ThreadPool::stop()
+{
+	waitIdle();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+		error = NULL;
+	}
+	taskReady.notify_all();
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+	for (size_t i = 0; i < workers.size(); i++)
+		delete workers[i];
+	threads.clear();
+	workers.clear();
+}
+
+/*
+	GETTERS
+*/
+
+size_t ThreadPool::getThreadCount() const
+{
+	return config.threads;
+}
+
+const ThreadPool::Config &ThreadPool::getConfig() const
+{
+	return config;
+}
+
+bool ThreadPool::isWorkerThread() const
+{
+	return currentPool == this;
+}
+
+/*
+	Small work or a single worker: not worth a hand-off.
+*/
+bool ThreadPool::runsSerially(size_t work) const
+{
+	return work < config.serialCutoff || config.threads < 2;
+}
+
+/*
+	Restarts the workers with a new configuration. Must not be called from
+	a worker or while other threads are submitting.
+*/
+void ThreadPool::configure(const Config &config)
+{
+	stop();
+	this->config = config;
+	this->config.threads = std::max<size_t>(1, config.threads);
+	start();
+}
+
+/*
+
+	Scheduling
+
+	A worker pushes onto its own deque, anyone else onto the injection
+	queue. The queued counter is raised before sleeping is checked and a
+	worker raises sleeping before it checks queued, so a task can never be
+	left behind with every worker parked.
+
+*/
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	pending.fetch_add(1);
+	queued.fetch_add(1);
+	if (isWorkerThread())
+	{
+		Worker *self = workers[currentIndex];
+		std::lock_guard<std::mutex> lock(self->mutex);
+		self->tasks.push_back(std::move(task));
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		injected.push_back(std::move(task));
+	}
+	if (sleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		taskReady.notify_one();
+	}
+}
+
+void ThreadPool::waitIdle()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	allDone.wait(lock, [this]() { return pending.load() == 0; });
+}
+
+void ThreadPool::wait()
+{
+	waitIdle();
+	std::exception_ptr failed;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::swap(failed, error);
+	}
+	if (failed)
+		std::rethrow_exception(failed);
+}
+
+/*
+	The exception of a task stays on the pool: leaving the worker thread
+	would terminate the process, and pending has to drop either way or
+	wait() never returns.
+*/
+void ThreadPool::runTask(std::function<void()> &task)
+{
+	try {
+		task();
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!error)
+			error = std::current_exception();
+	}
+	if (pending.fetch_sub(1) == 1)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		allDone.notify_all();
+	}
+}
+
+/*
+	Own deque from the back (newest, still in cache), then the injection
+	queue, then the front (oldest) of the other workers' deques.
+*/
+bool ThreadPool::tryRunOne(size_t index)
+{
+	std::function<void()> task;
+	{
+		Worker *self = workers[index];
+		std::lock_guard<std::mutex> lock(self->mutex);
+		if (!self->tasks.empty())
+		{
+			task = std::move(self->tasks.back());
+			self->tasks.pop_back();
+		}
+	}
+	if (!task)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!injected.empty())
+		{
+			task = std::move(injected.front());
+			injected.pop_front();
+		}
+	}
+	for (size_t k = 1; !task && k < workers.size(); k++)
+	{
+		Worker *victim = workers[(index + k) % workers.size()];
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (!victim->tasks.empty())
+		{
+			task = std::move(victim->tasks.front());
+			victim->tasks.pop_front();
+		}
+	}
+	if (!task)
+		return false;
+	queued.fetch_sub(1);
+	runTask(task);
+	return true;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+	currentPool = this;
+	currentIndex = index;
+	for (;;)
+	{
+		if (tryRunOne(index))
+			continue;
+
+		bool found = false;
+		for (size_t spin = 0; spin < config.spinIterations && !found; spin++)
+		{
+			std::this_thread::yield();
+			found = queued.load(std::memory_order_relaxed) > 0 && tryRunOne(index);
+		}
+		if (found)
+			continue;
+
+		std::unique_lock<std::mutex> lock(mutex);
+		if (stopping && pending.load() == 0)
+			return;
+		sleeping.fetch_add(1);
+		taskReady.wait(lock, [this]() { return stopping || queued.load() > 0; });
+		sleeping.fetch_sub(1);
+		if (stopping && pending.load() == 0)
+			return;
+	}
+}
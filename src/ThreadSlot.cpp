@@ -0,0 +1,45 @@
+#include "../include/ThreadSlot.hpp"
+#include <mutex>
+#include <vector>
+
+namespace {
+
+std::mutex			slotMutex;
+std::vector<bool>	slotUsed;
+
+size_t claimSlot()
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	for (size_t i = 0; i < slotUsed.size(); i++)
+	{
+		if (!slotUsed[i])
+		{
+			slotUsed[i] = true;
+			return i;
+		}
+	}
+	slotUsed.push_back(true);
+	return slotUsed.size() - 1;
+}
+
+void releaseSlot(size_t slot)
+{
+	std::lock_guard<std::mutex> lock(slotMutex);
+	slotUsed[slot] = false;
+}
+
+struct SlotHolder
+{
+	size_t slot;
+
+	SlotHolder() : slot(claimSlot()) {}
+	~SlotHolder() { releaseSlot(slot); }
+};
+
+}
+
+size_t threadSlot()
+{
+	thread_local SlotHolder holder;
+	return holder.slot;
+}
@@ -0,0 +1,123 @@
+#include "../include/TilePipeline.hpp"
+#include <stdexcept>
+
+TilePipeline::TilePipeline(Matrix &matrix, ThreadPool &pool)
+	: matrix(matrix), pool(pool), rowsReady(0)
+{
+}
+
+/*
+	Tiles still waiting would read rows that were never published,
+	so the pipeline is finished and drained before it goes away.
+*/
+TilePipeline::~TilePipeline()
+{
+	finish();
+	for (size_t i = 0; i < futures.size(); i++)
+		futures[i].wait();
+}
+
+size_t TilePipeline::getRowsReady() const
+{
+	return rowsReady.load(std::memory_order_acquire);
+}
+
+void TilePipeline::dispatch(const Tile &tile)
+{
+	Matrix *m = &matrix;
+	pool.submit([m, tile]() {
+		try
+		{
+			MatrixView view(*m, tile.startRow, tile.startCol, tile.numRows, tile.numCols);
+			tile.result->set_value(view.frobeniusNorm());
+		}
+		catch (...)
+		{
+			tile.result->set_exception(std::current_exception());
+		}
+	});
+}
+
+/*
+	Rows [0, rowsReady) are complete. Every waiting tile that ends at or
+	below the new watermark is handed to the pool.
+*/
+void TilePipeline::publishRows(size_t rowsReady)
+{
+	if (rowsReady > matrix.getRows())
+		rowsReady = matrix.getRows();
+
+	std::vector<Tile> ready;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (rowsReady <= this->rowsReady.load(std::memory_order_relaxed))
+			return;
+		this->rowsReady.store(rowsReady, std::memory_order_release);
+		std::multimap<size_t, Tile>::iterator end = waiting.upper_bound(rowsReady);
+		for (std::multimap<size_t, Tile>::iterator it = waiting.begin(); it != end; ++it)
+			ready.push_back(it->second);
+		waiting.erase(waiting.begin(), end);
+	}
+	rowsPublished.notify_all();
+	for (size_t i = 0; i < ready.size(); i++)
+		dispatch(ready[i]);
+}
+
+void TilePipeline::finish()
+{
+	publishRows(matrix.getRows());
+}
+
+/*
+	Returns an id for result(). A tile whose rows are already published
+	starts immediately.
+*/
+size_t TilePipeline::submit(size_t startRow, size_t startCol, size_t numRows, size_t numCols)
+{
+	if (startRow + numRows > matrix.getRows() || startCol + numCols > matrix.getCols())
+		throw std::out_of_range("MatrixView dimensions exceed matrix bounds");
+
+	Tile tile = {startRow, startCol, numRows, numCols, std::make_shared<std::promise<double>>()};
+	size_t id;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		id = futures.size();
+		futures.push_back(tile.result->get_future().share());
+		if (startRow + numRows > rowsReady.load(std::memory_order_relaxed))
+		{
+			waiting.insert(std::make_pair(startRow + numRows, tile));
+			return id;
+		}
+	}
+	dispatch(tile);
+	return id;
+}
+
+void TilePipeline::waitForRows(size_t rows)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	rowsPublished.wait(lock, [this, rows]() { return rowsReady.load() >= rows; });
+}
+
+double TilePipeline::result(size_t id)
+{
+	std::shared_future<double> future;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		future = futures.at(id);
+	}
+	return future.get();
+}
+
+std::vector<double> TilePipeline::results()
+{
+	std::vector<std::shared_future<double>> all;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		all = futures;
+	}
+	std::vector<double> values(all.size());
+	for (size_t i = 0; i < all.size(); i++)
+		values[i] = all[i].get();
+	return values;
+}
@@ -0,0 +1,296 @@
+#include "../include/VersionedMatrix.hpp"
+#include "../include/ThreadSlot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+/*
+
+	Version
+
+	Immutable once published: the row pointer table points into blocks
+	that are shared with the versions before and after it.
+	The wrapped Matrix gets the exact sum of squares tracked by the writer,
+	so frobeniusNorm() on a snapshot is a pure read.
+
+*/
+
+VersionedMatrix::Version::Version(uint64_t epoch, const std::vector<std::shared_ptr<double[]>> &blocks,
+	std::vector<double *> &&rowPtrs, size_t cols, double sum)
+	: epoch(epoch), blocks(blocks), rowPtrs(std::move(rowPtrs)),
+	matrix(Matrix::wrap(this->rowPtrs.data(), this->rowPtrs.size(), cols))
+{
+	matrix.setSum(sum);
+	matrix.setSumComputed(true);
+}
+
+/*
+
+	Constructors
+
+*/
+
+VersionedMatrix::VersionedMatrix(size_t rows, size_t cols, size_t blockRows, size_t maxReaders)
+	: rows(rows), cols(cols), blockRows(std::max<size_t>(1, blockRows)), workSum(0),
+	current(NULL), globalEpoch(0), slots(new ReaderSlot[std::max<size_t>(1, maxReaders)]),
+	slotCount(std::max<size_t>(1, maxReaders))
+{
+	size_t blockCount = (rows + this->blockRows - 1) / this->blockRows;
+	for (size_t b = 0; b < blockCount; b++)
+	{
+		size_t n = std::min(this->blockRows, rows - b * this->blockRows) * cols;
+		workBlocks.push_back(std::shared_ptr<double[]>(new double[n]()));
+	}
+	init();
+}
+
+VersionedMatrix::VersionedMatrix(const Matrix &initial, size_t blockRows, size_t maxReaders)
+	: VersionedMatrix(initial.getRows(), initial.getCols(), blockRows, maxReaders)
+{
+	double **src = initial.getRawMatrix();
+	double scale = initial.getPendingScale();
+	workSum = 0;
+	for (size_t i = 0; i < rows; i++)
+	{
+		double *dst = workBlocks[i / this->blockRows].get() + (i % this->blockRows) * cols;
+		std::memcpy(dst, src[i], cols * sizeof(double));
+		for (size_t j = 0; j < cols; j++)
+		{
+			dst[j] *= scale;
+			workSum += dst[j] * dst[j];
+		}
+	}
+	// republish so the current version carries the copied sum of squares
+	publish();
+	reclaim();
+}
+
+void VersionedMatrix::init()
+{
+	workOwned.assign(workBlocks.size(), false);
+	for (size_t i = 0; i < slotCount; i++)
+		slots[i].epoch.store(FREE_SLOT, std::memory_order_relaxed);
+
+	std::vector<double *> rowPtrs(rows);
+	for (size_t i = 0; i < rows; i++)
+		rowPtrs[i] = workBlocks[i / blockRows].get() + (i % blockRows) * cols;
+	current.store(new Version(0, workBlocks, std::move(rowPtrs), cols, workSum));
+}
+
+VersionedMatrix::~VersionedMatrix()
+{
+	for (size_t i = 0; i < retired.size(); i++)
+		delete retired[i].first;
+	delete current.load();
+	delete[] slots;
+}
+
+/*
+	GETTERS
+*/
+
+size_t VersionedMatrix::getRows() const
+{
+	return rows;
+}
+
+size_t VersionedMatrix::getCols() const
+{
+	return cols;
+}
+
+size_t VersionedMatrix::getBlockRows() const
+{
+	return blockRows;
+}
+
+size_t VersionedMatrix::getRetiredCount() const
+{
+	return retired.size();
+}
+
+/*
+
+	Writer
+
+	A block is copied the first time it is modified after a publish, later
+	writes to it in the same epoch go straight to the private copy.
+
+*/
+
+double *VersionedMatrix::writableRow(size_t row)
+{
+	size_t b = row / blockRows;
+	if (!workOwned[b])
+	{
+		size_t n = std::min(blockRows, rows - b * blockRows) * cols;
+		std::shared_ptr<double[]> copy(new double[n]);
+		std::memcpy(copy.get(), workBlocks[b].get(), n * sizeof(double));
+		workBlocks[b] = copy;
+		workOwned[b] = true;
+	}
+	return workBlocks[b].get() + (row % blockRows) * cols;
+}
+
+double VersionedMatrix::getValue(size_t row, size_t col) const
+{
+	if (row >= rows || col >= cols)
+		throw std::out_of_range("Index out of range");
+	return workBlocks[row / blockRows][(row % blockRows) * cols + col];
+}
+
+void VersionedMatrix::setValue(size_t row, size_t col, double value)
+{
+	if (row >= rows || col >= cols)
+		throw std::out_of_range("Index out of range");
+	double *r = writableRow(row);
+	workSum += value * value - r[col] * r[col];
+	r[col] = value;
+}
+
+/*
+	Swap in the new version first, then advance the epoch: a reader that
+	announces the new epoch is guaranteed to load the new version.
+*/
+void VersionedMatrix::publish()
+{
+	std::vector<double *> rowPtrs(rows);
+	for (size_t i = 0; i < rows; i++)
+		rowPtrs[i] = workBlocks[i / blockRows].get() + (i % blockRows) * cols;
+
+	uint64_t epoch = globalEpoch.load() + 1;
+	Version *next = new Version(epoch, workBlocks, std::move(rowPtrs), cols, workSum);
+	Version *old = current.exchange(next);
+	globalEpoch.store(epoch);
+	retired.push_back(std::make_pair(old, epoch));
+	workOwned.assign(workBlocks.size(), false);
+	reclaim();
+}
+
+uint64_t VersionedMatrix::oldestPinnedEpoch() const
+{
+	uint64_t oldest = FREE_SLOT;
+	for (size_t i = 0; i < slotCount; i++)
+		oldest = std::min(oldest, slots[i].epoch.load());
+	return oldest;
+}
+
+/*
+	A version retired when the epoch became E can only be seen by readers
+	that pinned an epoch below E.
+*/
+void VersionedMatrix::reclaim()
+{
+	uint64_t oldest = oldestPinnedEpoch();
+	size_t kept = 0;
+	for (size_t i = 0; i < retired.size(); i++)
+	{
+		if (retired[i].second <= oldest)
+			delete retired[i].first;
+		else
+			retired[kept++] = retired[i];
+	}
+	retired.resize(kept);
+}
+
+/*
+
+	Reader
+
+	Pinning claims any free slot with a CAS, starting from the slot of the
+	calling thread, so a reader never waits on the writer. With every slot
+	taken it waits for another reader instead: after each full pass over
+	the slots it yields, then sleeps with a doubling delay up to 1 ms.
+
+*/
+
+size_t VersionedMatrix::pin() const
+{
+	const size_t YIELD_PASSES = 16;
+	const std::chrono::microseconds MAX_DELAY(1000);
+	std::chrono::microseconds delay(1);
+	size_t start = threadSlot() % slotCount;
+	for (size_t pass = 0;; pass++)
+	{
+		for (size_t k = 0; k < slotCount; k++)
+		{
+			size_t i = (start + k) % slotCount;
+			uint64_t expected = FREE_SLOT;
+			if (slots[i].epoch.compare_exchange_strong(expected, globalEpoch.load()))
+				return i;
+		}
+		if (pass < YIELD_PASSES)
+			std::this_thread::yield();
+		else
+		{
+			std::this_thread::sleep_for(delay);
+			delay = std::min(delay * 2, MAX_DELAY);
+		}
+	}
+}
+
+void VersionedMatrix::unpin(size_t slot) const
+{
+	slots[slot].epoch.store(FREE_SLOT, std::memory_order_release);
+}
+
+VersionedMatrix::Snapshot VersionedMatrix::snapshot() const
+{
+	size_t slot = pin();
+	return Snapshot(this, slot, current.load());
+}
+
+VersionedMatrix::Snapshot::Snapshot(const VersionedMatrix *owner, size_t slot, const Version *version)
+	: owner(owner), slot(slot), version(version)
+{
+}
+
+VersionedMatrix::Snapshot::Snapshot(Snapshot &&other)
+	: owner(other.owner), slot(other.slot), version(other.version)
+{
+	other.owner = NULL;
+	other.version = NULL;
+}
+
+VersionedMatrix::Snapshot &VersionedMatrix::Snapshot::operator=(Snapshot &&other)
+{
+	if (this != &other)
+	{
+		if (owner != NULL)
+			owner->unpin(slot);
+		owner = other.owner;
+		slot = other.slot;
+		version = other.version;
+		other.owner = NULL;
+		other.version = NULL;
+	}
+	return *this;
+}
+
+VersionedMatrix::Snapshot::~Snapshot()
+{
+	if (owner != NULL)
+		owner->unpin(slot);
+}
+
+uint64_t VersionedMatrix::Snapshot::getEpoch() const
+{
+	return version->epoch;
+}
+
+const Matrix &VersionedMatrix::Snapshot::matrix() const
+{
+	return version->matrix;
+}
+
+ConstMatrixView VersionedMatrix::Snapshot::view(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const
+{
+	return ConstMatrixView(version->matrix, startRow, startCol, numRows, numCols);
+}
+
+double VersionedMatrix::Snapshot::frobeniusNorm() const
+{
+	return version->matrix.frobeniusNorm();
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "../include/apply.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Test apply on a view under every execution policy
+ *
+ * This test case verifies:
+ * 1. Only the elements inside the view are changed
+ * 2. seq, par and par_unseq give the same values
+ * 3. The view and parent norms match a fresh recomputation
+ */
+TEST(ApplyTest, ApplyOnViewKeepsNormsExact)
+{
+    const size_t n = 300;
+    Matrix a(n, n), b(n, n), c(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            double v = std::sin(i * 0.7 + j * 0.3) * 4.0;
+            a(i, j) = v;
+            b(i, j) = v;
+            c(i, j) = v;
+        }
+    a.frobeniusNorm();
+    b.frobeniusNorm();
+    c.frobeniusNorm();
+
+    auto clamp = [](double x) { return std::min(1.0, std::max(-1.0, x)); };
+    MatrixView va(a, 10, 20, 250, 271), vb(b, 10, 20, 250, 271), vc(c, 10, 20, 250, 271);
+    apply(policy::seq, va, clamp);
+    apply(policy::par, vb, clamp);
+    apply(policy::par_unseq, vc, clamp);
+
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            bool inside = i >= 10 && i < 260 && j >= 20 && j < 291;
+            double v = std::sin(i * 0.7 + j * 0.3) * 4.0;
+            double expected = inside ? clamp(v) : v;
+            ASSERT_DOUBLE_EQ(a.getValue(i, j), expected);
+            ASSERT_DOUBLE_EQ(b.getValue(i, j), expected);
+            ASSERT_DOUBLE_EQ(c.getValue(i, j), expected);
+        }
+
+    Matrix copy(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+            copy(i, j) = a.getValue(i, j);
+    double fresh = copy.frobeniusNorm();
+    EXPECT_NEAR(a.frobeniusNorm(), fresh, 1e-9 * fresh);
+    EXPECT_NEAR(b.frobeniusNorm(), fresh, 1e-9 * fresh);
+    EXPECT_NEAR(c.frobeniusNorm(), fresh, 1e-9 * fresh);
+
+    MatrixView again(a, 10, 20, 250, 271);
+    EXPECT_NEAR(va.frobeniusNorm(), again.frobeniusNorm(), 1e-9 * again.frobeniusNorm());
+}
+
+/**
+ * @brief Test transform between matrices and views
+ *
+ * This test case verifies:
+ * 1. transform writes f(src) into dst and leaves src untouched
+ * 2. The destination norm is exact without a recomputation pass
+ * 3. Mismatched or partially overlapping tiles throw std::invalid_argument
+ */
+TEST(ApplyTest, TransformMatricesAndViews)
+{
+    Matrix src(64, 48, 2.0);
+    Matrix dst(64, 48, 5.0);
+    transform(src, dst, [](double x) { return x * 3.0; });
+    for (size_t i = 0; i < 64; ++i)
+        for (size_t j = 0; j < 48; ++j)
+        {
+            ASSERT_DOUBLE_EQ(dst.getValue(i, j), 6.0);
+            ASSERT_DOUBLE_EQ(src.getValue(i, j), 2.0);
+        }
+    EXPECT_TRUE(dst.getSumComputed());
+    EXPECT_NEAR(dst.frobeniusNorm(), std::sqrt(36.0 * 64 * 48), 1e-9);
+
+    apply(policy::seq, dst, [](double x) { return std::log(x); });
+    EXPECT_NEAR(dst.frobeniusNorm(), std::log(6.0) * std::sqrt(64.0 * 48), 1e-9);
+
+    MatrixView left(src, 0, 0, 8, 8);
+    MatrixView shifted(src, 4, 4, 8, 8);
+    MatrixView wrongShape(src, 0, 0, 8, 7);
+    EXPECT_THROW(transform(policy::seq, left, shifted, [](double x) { return x; }), std::invalid_argument);
+    EXPECT_THROW(transform(policy::seq, left, wrongShape, [](double x) { return x; }), std::invalid_argument);
+
+    MatrixView same(src, 0, 0, 8, 8);
+    transform(policy::par_unseq, left, same, [](double x) { return x > 1.0 ? 1.0 : 0.0; });
+    EXPECT_DOUBLE_EQ(src.getValue(7, 7), 1.0);
+    EXPECT_DOUBLE_EQ(same.frobeniusNorm(), 8.0);
+}
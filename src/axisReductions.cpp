@@ -0,0 +1,151 @@
+#include "../include/axisReductions.hpp"
+#include "../include/reduce.hpp"
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Tile {
+	double	**rows;
+	size_t	startRow;
+	size_t	startCol;
+	size_t	numRows;
+	size_t	numCols;
+};
+
+Tile tileOf(const MatrixView& view)
+{
+	Tile t = {view.matrix_ptr, view.getStartRow(), view.getStartCol(), view.getRows(), view.getCols()};
+	return t;
+}
+
+// rows as stored, the Matrix overloads put the pending scale on the results
+Tile tileOf(const Matrix& m)
+{
+	Tile t = {m.getRawMatrix(), 0, 0, m.getRows(), m.getCols()};
+	return t;
+}
+
+/*
+	One reducer per row, rows in parallel.
+*/
+template <typename R>
+void reduceRows(const Tile& t, R reducer, std::vector<double>& out)
+{
+	out.resize(t.numRows);
+	ThreadPool::instance().parallelFor(0, t.numRows, t.numCols, [&](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+		{
+			typename R::State s = reducer.init();
+			reducer.accumulate(s, t.rows[t.startRow + i] + t.startCol, t.numCols);
+			out[i] = reducer.finish(s, t.numCols);
+		}
+	});
+}
+
+/*
+	acc[j] = step(acc[j], x[j]) row after row. The inner loop is a plain
+	element-wise update over contiguous memory, so it vectorises; every
+	chunk of rows gets its own partial vector, merged in chunk order.
+*/
+template <typename Step, typename Merge>
+void reduceCols(const Tile& t, double identity, Step step, Merge merge, std::vector<double>& out)
+{
+	size_t numCols = t.numCols;
+	out = ThreadPool::instance().parallelReduce(0, t.numRows, numCols, std::vector<double>(numCols, identity),
+		[&](size_t lo, size_t hi) {
+			std::vector<double> acc(numCols, identity);
+			double *a = acc.data();
+			for (size_t i = lo; i < hi; i++)
+			{
+				const double *x = t.rows[t.startRow + i] + t.startCol;
+				for (size_t j = 0; j < numCols; j++)
+					a[j] = step(a[j], x[j]);
+			}
+			return acc;
+		},
+		[&](std::vector<double> a, const std::vector<double>& b) {
+			for (size_t j = 0; j < numCols; j++)
+				a[j] = merge(a[j], b[j]);
+			return a;
+		});
+}
+
+double plus(double a, double b) { return a + b; }
+double larger(double a, double b) { return a > b ? a : b; }
+
+void colSumsOfSquares(const Tile& t, std::vector<double>& out)
+{
+	reduceCols(t, 0.0, [](double a, double x) { return a + x * x; }, plus, out);
+}
+
+void sqrtAll(std::vector<double>& v)
+{
+	for (size_t j = 0; j < v.size(); j++)
+		v[j] = std::sqrt(v[j]);
+}
+
+void scaleAll(std::vector<double>& v, double factor)
+{
+	if (factor == 1.0)
+		return;
+	for (size_t j = 0; j < v.size(); j++)
+		v[j] *= factor;
+}
+
+}
+
+void rowSums(const MatrixView& view, std::vector<double>& out)
+{
+	reduceRows(tileOf(view), SumReducer(), out);
+}
+
+void rowNorms(const MatrixView& view, std::vector<double>& out)
+{
+	reduceRows(tileOf(view), FrobeniusReducer(), out);
+}
+
+void rowL1Norms(const MatrixView& view, std::vector<double>& out)
+{
+	reduceRows(tileOf(view), L1Reducer(), out);
+}
+
+void rowMaxAbs(const MatrixView& view, std::vector<double>& out)
+{
+	reduceRows(tileOf(view), MaxAbsReducer(), out);
+}
+
+void colSums(const MatrixView& view, std::vector<double>& out)
+{
+	reduceCols(tileOf(view), 0.0, plus, plus, out);
+}
+
+void colNorms(const MatrixView& view, std::vector<double>& out)
+{
+	colSumsOfSquares(tileOf(view), out);
+	sqrtAll(out);
+}
+
+void colL1Norms(const MatrixView& view, std::vector<double>& out)
+{
+	reduceCols(tileOf(view), 0.0, [](double a, double x) { return a + std::fabs(x); }, plus, out);
+}
+
+void colMaxAbs(const MatrixView& view, std::vector<double>& out)
+{
+	reduceCols(tileOf(view), 0.0, [](double a, double x) { return larger(a, std::fabs(x)); }, larger, out);
+}
+
+void rowNorms(const Matrix& m, std::vector<double>& out)
+{
+	reduceRows(tileOf(m), FrobeniusReducer(), out);
+	scaleAll(out, std::fabs(m.getPendingScale()));
+}
+
+void colNorms(const Matrix& m, std::vector<double>& out)
+{
+	colSumsOfSquares(tileOf(m), out);
+	sqrtAll(out);
+	scaleAll(out, std::fabs(m.getPendingScale()));
+}
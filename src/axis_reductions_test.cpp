@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "../include/axisReductions.hpp"
+#include <cmath>
+
+/**
+ * @brief Test the row-wise reductions
+ *
+ * This test case verifies:
+ * 1. rowNorms matches the norm of a 1xN view for every row
+ * 2. rowSums, rowL1Norms and rowMaxAbs return the expected values
+ * 3. The output vector is resized to the number of rows of the view
+ */
+TEST(AxisReductionsTest, RowReductions)
+{
+    Matrix m(5, 6);
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 6; ++j)
+            m(i, j) = (j % 2 == 0 ? 1.0 : -1.0) * (i + j);
+    MatrixView view(m, 1, 1, 3, 4);
+
+    std::vector<double> out(1, 42.0);
+    rowNorms(view, out);
+    ASSERT_EQ(out.size(), 3);
+    for (size_t i = 0; i < 3; ++i)
+        EXPECT_DOUBLE_EQ(out[i], MatrixView(m, i + 1, 1, 1, 4).frobeniusNorm());
+
+    rowSums(view, out);
+    EXPECT_DOUBLE_EQ(out[0], -2.0 + 3.0 - 4.0 + 5.0);
+    rowL1Norms(view, out);
+    EXPECT_DOUBLE_EQ(out[0], 14.0);
+    rowMaxAbs(view, out);
+    EXPECT_DOUBLE_EQ(out[2], 7.0);
+
+    rowNorms(m, out);
+    ASSERT_EQ(out.size(), 5);
+    EXPECT_DOUBLE_EQ(out[0], std::sqrt(0.0 + 1 + 4 + 9 + 16 + 25));
+}
+
+/**
+ * @brief Test the column-wise reductions
+ *
+ * This test case verifies:
+ * 1. colNorms matches the norm of an Nx1 view for every column
+ * 2. colSums, colL1Norms and colMaxAbs return the expected values
+ * 3. A tall matrix split across several chunks gives exact column sums
+ */
+TEST(AxisReductionsTest, ColumnReductions)
+{
+    Matrix m(5, 6);
+    for (size_t i = 0; i < 5; ++i)
+        for (size_t j = 0; j < 6; ++j)
+            m(i, j) = (i % 2 == 0 ? 1.0 : -1.0) * (i + j);
+    MatrixView view(m, 1, 2, 4, 3);
+
+    std::vector<double> out;
+    colNorms(view, out);
+    ASSERT_EQ(out.size(), 3);
+    for (size_t j = 0; j < 3; ++j)
+        EXPECT_DOUBLE_EQ(out[j], MatrixView(m, 1, j + 2, 4, 1).frobeniusNorm());
+
+    colSums(view, out);
+    EXPECT_DOUBLE_EQ(out[0], -3.0 + 4.0 - 5.0 + 6.0);
+    colL1Norms(view, out);
+    EXPECT_DOUBLE_EQ(out[0], 18.0);
+    colMaxAbs(view, out);
+    EXPECT_DOUBLE_EQ(out[2], 8.0);
+
+    Matrix tall(5000, 3, 2.0);
+    colNorms(tall, out);
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_DOUBLE_EQ(out[1], std::sqrt(4.0 * 5000));
+}
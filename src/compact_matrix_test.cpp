@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "../include/CompactMatrix.hpp"
+#include "test_matrices.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// smooth values spread over a few magnitudes
+double sample(size_t i, size_t j)
+{
+    return std::sin(0.1 * i + 0.7 * j) * (1.0 + j % 3);
+}
+
+template <typename T>
+void checkNorms(double tolerance)
+{
+    const size_t rows = 37, cols = 29;
+    Matrix source = filledMatrix(rows, cols, sample);
+    CompactMatrix<T> compact(source);
+    EXPECT_EQ(compact.getBytes(), rows * cols * sizeof(T));
+
+    Matrix stored = compact.toMatrix();
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+        {
+            ASSERT_EQ(compact.getValue(i, j), stored(i, j));
+            ASSERT_NEAR(compact.getValue(i, j), source(i, j), tolerance * (1 + std::fabs(source(i, j))));
+        }
+
+    EXPECT_NEAR(compact.frobeniusNorm(), stored.frobeniusNorm(), 1e-12 * stored.frobeniusNorm());
+    CompactMatrixView<T> tile = compact.view(3, 5, 20, 19);
+    MatrixView expected(stored, 3, 5, 20, 19);
+    EXPECT_NEAR(tile.frobeniusNorm(), expected.frobeniusNorm(), 1e-12 * expected.frobeniusNorm());
+    EXPECT_EQ(tile.getValue(2, 3), stored(5, 8));
+
+    Matrix widened = tile.toMatrix();
+    EXPECT_EQ(widened.getRows(), 20u);
+    EXPECT_EQ(widened(19, 18), stored(22, 23));
+
+    compact.setValue(4, 4, 3.0);
+    stored(4, 4) = 3.0;
+    EXPECT_NEAR(compact.frobeniusNorm(), stored.frobeniusNorm(), 1e-12 * stored.frobeniusNorm());
+    EXPECT_THROW(compact.getValue(rows, 0), std::out_of_range);
+    EXPECT_THROW(compact.view(30, 0, 8, 1), std::out_of_range);
+}
+
+}
+
+/**
+ * @brief Test the 16-bit conversions
+ *
+ * This test case verifies:
+ * 1. Every non-NaN bfloat16 and float16 bit pattern survives a round trip through float
+ * 2. Narrowing rounds to nearest even
+ * 3. float16 overflow, subnormals and NaN are handled
+ * 4. The span conversions agree with the scalar ones
+ */
+TEST(CompactMatrixTest, Conversions)
+{
+    for (uint32_t bits = 0; bits <= 0xffff; ++bits)
+    {
+        bfloat16 b = {static_cast<uint16_t>(bits)};
+        float16 h = {static_cast<uint16_t>(bits)};
+        if (!std::isnan(toFloat(b)))
+        {
+            ASSERT_EQ(toBFloat16(toFloat(b)).bits, bits);
+        }
+        if (!std::isnan(toFloat(h)))
+        {
+            ASSERT_EQ(toFloat16(toFloat(h)).bits, bits);
+        }
+    }
+
+    EXPECT_EQ(toFloat(toBFloat16(1.0f + std::ldexp(1.0f, -8))), 1.0f);
+    EXPECT_EQ(toFloat(toBFloat16(1.0f + 3 * std::ldexp(1.0f, -8))), 1.0f + std::ldexp(1.0f, -6));
+    EXPECT_EQ(toFloat(toFloat16(1.0f + std::ldexp(1.0f, -11))), 1.0f);
+    EXPECT_EQ(toFloat(toFloat16(65504.0f)), 65504.0f);
+    EXPECT_TRUE(std::isinf(toFloat(toFloat16(70000.0f))));
+    EXPECT_EQ(toFloat(toFloat16(std::ldexp(1.0f, -24))), std::ldexp(1.0f, -24));
+    EXPECT_EQ(toFloat(toFloat16(std::ldexp(1.0f, -25))), 0.0f);
+    EXPECT_EQ(toFloat(toFloat16(-0.15625f)), -0.15625f);
+    EXPECT_TRUE(std::isnan(toFloat(toFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_TRUE(std::isnan(toFloat(toBFloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+    std::vector<double> values, back(11);
+    for (int k = 0; k < 11; ++k)
+        values.push_back(0.3 * k - 1.7);
+    std::vector<float16> halves(11);
+    narrowSpan(halves.data(), values.data(), values.size());
+    widenSpan(back.data(), halves.data(), halves.size());
+    for (size_t k = 0; k < values.size(); ++k)
+    {
+        EXPECT_EQ(halves[k].bits, narrow<float16>(values[k]).bits);
+        EXPECT_EQ(back[k], widen(halves[k]));
+    }
+}
+
+/**
+ * @brief Test values and norms of every storage format
+ *
+ * This test case verifies:
+ * 1. getValue returns the stored value widened, within the format's precision of the source
+ * 2. Matrix and tile norms match the double norms of the stored values
+ * 3. setValue keeps the cached norm in step
+ * 4. Out-of-range access and tiles throw
+ */
+TEST(CompactMatrixTest, NormsAndValues)
+{
+    checkNorms<float>(1e-7);
+    checkNorms<bfloat16>(1e-2);
+    checkNorms<float16>(1e-3);
+}
+
+/**
+ * @brief Test reduce() over compact storage
+ *
+ * This test case verifies:
+ * 1. The reducers see the widened values of the tile
+ * 2. Results match reduce() over the equivalent double tile
+ */
+TEST(CompactMatrixTest, Reduce)
+{
+    Matrix source = filledMatrix(50, 600, sample);
+    CompactMatrix<bfloat16> compact(source);
+    Matrix stored = compact.toMatrix();
+
+    double sum, lo, hi, frob;
+    std::tie(sum, lo, hi, frob) =
+        reduce(compact.view(2, 7, 40, 530), SumReducer(), MinReducer(), MaxReducer(), FrobeniusReducer());
+    MatrixView expected(stored, 2, 7, 40, 530);
+    double sum2, lo2, hi2, frob2;
+    std::tie(sum2, lo2, hi2, frob2) =
+        reduce(expected, SumReducer(), MinReducer(), MaxReducer(), FrobeniusReducer());
+    EXPECT_NEAR(sum, sum2, 1e-9);
+    EXPECT_EQ(lo, lo2);
+    EXPECT_EQ(hi, hi2);
+    EXPECT_NEAR(frob, frob2, 1e-9 * frob2);
+
+    double mean = std::get<0>(reduce(compact, MeanReducer()));
+    EXPECT_NEAR(mean, std::get<0>(reduce(stored, MeanReducer())), 1e-12);
+}
@@ -1,4 +1,9 @@
 #include "../include/frobeniusNorm.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/rowKernels.hpp"
+#include <cmath>
+#include <functional>
+#include <stdexcept>
 
 double frobeniusNorm(const Matrix& m) {
     return m.frobeniusNorm();
@@ -6,4 +11,151 @@ double frobeniusNorm(const Matrix& m) {
 
 // double frobeniusNorm(const MatrixView& view) {
 //     return view.frobeniusNorm();
-// }
\ No newline at end of file
+// }
+
+/*
+    One task per group of tiles; each tile's own scan stays serial inside
+    a worker unless it is big enough to be split further.
+*/
+std::vector<double> frobeniusNorms(const std::vector<MatrixView>& views) {
+    std::vector<double> norms(views.size());
+    size_t cost = 0;
+    for (size_t i = 0; i < views.size(); i++)
+        cost += views[i].getRows() * views[i].getCols();
+    size_t average = views.empty() ? 0 : cost / views.size();
+    ThreadPool::instance().parallelFor(0, views.size(), average, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; i++)
+            norms[i] = views[i].frobeniusNorm();
+    });
+    return norms;
+}
+
+/*
+    Comparisons
+*/
+
+namespace {
+
+// elements of a reference tile that stay cached while it is compared
+const size_t CACHED_REFERENCE_ELEMENTS = size_t(32) << 10;
+
+struct Rows {
+    double  **rows;
+    size_t  startRow;
+    size_t  startCol;
+
+    const double *row(size_t i) const { return rows[startRow + i] + startCol; }
+};
+
+Rows rowsOf(const MatrixView& view)
+{
+    Rows r = {view.matrix_ptr, view.getStartRow(), view.getStartCol()};
+    return r;
+}
+
+void checkShapes(size_t rows, size_t cols, const MatrixView& other, const char *what)
+{
+    if (other.getRows() != rows || other.getCols() != cols)
+        throw std::invalid_argument(what);
+}
+
+// sum over the rows of f(row of a, row of b, cols), in parallel
+template <typename F>
+double pairReduce(Rows a, Rows b, size_t rows, size_t cols, F f)
+{
+    return ThreadPool::instance().parallelReduce(0, rows, cols, 0.0, [=](size_t lo, size_t hi) {
+        double sum = 0;
+        for (size_t i = lo; i < hi; i++)
+            sum += f(a.row(i), b.row(i), cols);
+        return sum;
+    }, std::plus<double>());
+}
+
+template <typename F>
+std::vector<double> batchReduce(const MatrixView& ref, const std::vector<MatrixView>& others, F f,
+    const char *what)
+{
+    size_t rows = ref.getRows(), cols = ref.getCols(), count = others.size();
+    for (size_t k = 0; k < count; k++)
+        checkShapes(rows, cols, others[k], what);
+    Rows r = rowsOf(ref);
+
+    std::vector<double> sums(count, 0.0);
+    if (rows * cols <= CACHED_REFERENCE_ELEMENTS)
+    {
+        ThreadPool::instance().parallelFor(0, count, rows * cols, [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; k++)
+            {
+                Rows o = rowsOf(others[k]);
+                double sum = 0;
+                for (size_t i = 0; i < rows; i++)
+                    sum += f(r.row(i), o.row(i), cols);
+                sums[k] = sum;
+            }
+        });
+        return sums;
+    }
+    return ThreadPool::instance().parallelReduce(0, rows, cols * count, sums, [&](size_t lo, size_t hi) {
+        std::vector<double> partial(count, 0.0);
+        for (size_t i = lo; i < hi; i++)
+        {
+            const double *row = r.row(i);
+            for (size_t k = 0; k < count; k++)
+                partial[k] += f(row, rowsOf(others[k]).row(i), cols);
+        }
+        return partial;
+    }, [](std::vector<double> a, const std::vector<double>& b) {
+        for (size_t k = 0; k < a.size(); k++)
+            a[k] += b[k];
+        return a;
+    });
+}
+
+double dotSpan(const double *a, const double *b, size_t n)
+{
+    return dot(a, b, n);
+}
+
+double distanceSpan(const double *a, const double *b, size_t n)
+{
+    return squaredDistance(a, b, n);
+}
+
+}
+
+double frobeniusDot(const MatrixView& a, const MatrixView& b) {
+    checkShapes(a.getRows(), a.getCols(), b, "frobeniusDot: shapes do not match");
+    return pairReduce(rowsOf(a), rowsOf(b), a.getRows(), a.getCols(), dotSpan);
+}
+
+double frobeniusDistance(const MatrixView& a, const MatrixView& b) {
+    checkShapes(a.getRows(), a.getCols(), b, "frobeniusDistance: shapes do not match");
+    return std::sqrt(pairReduce(rowsOf(a), rowsOf(b), a.getRows(), a.getCols(), distanceSpan));
+}
+
+double frobeniusDot(const Matrix& a, const Matrix& b) {
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
+        throw std::invalid_argument("frobeniusDot: shapes do not match");
+    Rows ra = {a.getRawMatrix(), 0, 0}, rb = {b.getRawMatrix(), 0, 0};
+    return a.getPendingScale() * b.getPendingScale() * pairReduce(ra, rb, a.getRows(), a.getCols(), dotSpan);
+}
+
+double frobeniusDistance(const Matrix& a, const Matrix& b) {
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
+        throw std::invalid_argument("frobeniusDistance: shapes do not match");
+    Rows ra = {a.getRawMatrix(), 0, 0}, rb = {b.getRawMatrix(), 0, 0};
+    double alpha = a.getPendingScale(), beta = b.getPendingScale();
+    return std::sqrt(pairReduce(ra, rb, a.getRows(), a.getCols(),
+        [alpha, beta](const double *x, const double *y, size_t n) { return squaredDistance(x, y, n, alpha, beta); }));
+}
+
+std::vector<double> frobeniusDots(const MatrixView& ref, const std::vector<MatrixView>& others) {
+    return batchReduce(ref, others, dotSpan, "frobeniusDots: shapes do not match");
+}
+
+std::vector<double> frobeniusDistances(const MatrixView& ref, const std::vector<MatrixView>& others) {
+    std::vector<double> distances = batchReduce(ref, others, distanceSpan, "frobeniusDistances: shapes do not match");
+    for (size_t k = 0; k < distances.size(); k++)
+        distances[k] = std::sqrt(distances[k]);
+    return distances;
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../include/frobeniusNorm.hpp"
+#include "test_matrices.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// element (i, j) of a sine wave shifted by phase
+auto wave(double phase)
+{
+    return [phase](size_t i, size_t j) { return std::sin(phase + 0.37 * i - 0.11 * j); };
+}
+
+void reference(const MatrixView& a, const MatrixView& b, double& dot, double& distance)
+{
+    dot = 0;
+    distance = 0;
+    for (size_t i = 0; i < a.getRows(); ++i)
+        for (size_t j = 0; j < a.getCols(); ++j)
+        {
+            dot += a.getValue(i, j) * b.getValue(i, j);
+            distance += (a.getValue(i, j) - b.getValue(i, j)) * (a.getValue(i, j) - b.getValue(i, j));
+        }
+    distance = std::sqrt(distance);
+}
+
+}
+
+/**
+ * @brief Test the Frobenius inner product and distance of two tiles
+ *
+ * This test case verifies:
+ * 1. Dot and distance of tiles of different matrices match a reference loop, odd widths included
+ * 2. The distance of nearly equal tiles does not cancel to zero
+ * 3. The Matrix overloads apply pending scale factors
+ * 4. Mismatched shapes throw
+ */
+TEST(FrobeniusTest, DotAndDistance)
+{
+    Matrix a = filledMatrix(90, 53, wave(0.0));
+    Matrix b = filledMatrix(70, 61, wave(1.0));
+    MatrixView ta(a, 3, 2, 60, 47);
+    MatrixView tb(b, 9, 13, 60, 47);
+    double dot, distance;
+    reference(ta, tb, dot, distance);
+    EXPECT_NEAR(frobeniusDot(ta, tb), dot, 1e-12 * std::abs(dot) + 1e-12);
+    EXPECT_NEAR(frobeniusDistance(ta, tb), distance, 1e-12 * distance);
+    EXPECT_DOUBLE_EQ(frobeniusDistance(ta, ta), 0.0);
+
+    Matrix c = a;
+    c(40, 20) = a(40, 20) + 1e-9;
+    EXPECT_NEAR(frobeniusDistance(a, c), 1e-9, 1e-15);
+
+    Matrix d = filledMatrix(90, 53, wave(1.0));
+    double plain = frobeniusDot(a, d);
+    a.scale(2.0);
+    d.scale(-0.5);
+    EXPECT_NEAR(frobeniusDot(a, d), -plain, 1e-12 * std::abs(plain));
+    Matrix sa = a, sd = d;
+    MatrixView va(sa, 0, 0, 90, 53), vd(sd, 0, 0, 90, 53);
+    EXPECT_NEAR(frobeniusDistance(a, d), frobeniusDistance(va, vd), 1e-12 * frobeniusDistance(va, vd));
+
+    MatrixView wrong(b, 0, 0, 60, 46);
+    EXPECT_THROW(frobeniusDot(ta, wrong), std::invalid_argument);
+    EXPECT_THROW(frobeniusDistance(ta, wrong), std::invalid_argument);
+}
+
+/**
+ * @brief Test one-against-many comparisons
+ *
+ * This test case verifies:
+ * 1. The batched results match the pairwise ones, for a small and for a large reference tile
+ * 2. An empty batch gives an empty result
+ * 3. A tile of another shape in the batch throws
+ */
+TEST(FrobeniusTest, Batched)
+{
+    Matrix ref = filledMatrix(400, 200, wave(0.5));
+    std::vector<Matrix> pool;
+    for (int k = 0; k < 6; ++k)
+        pool.push_back(filledMatrix(400, 200, wave(0.1 * k)));
+
+    const size_t shapes[][2] = {{7, 9}, {300, 150}};
+    for (const auto &shape : shapes)
+    {
+        MatrixView r(ref, 1, 2, shape[0], shape[1]);
+        std::vector<MatrixView> others;
+        for (size_t k = 0; k < pool.size(); ++k)
+            others.push_back(MatrixView(pool[k], k, 2 * k, shape[0], shape[1]));
+        std::vector<double> dots = frobeniusDots(r, others);
+        std::vector<double> distances = frobeniusDistances(r, others);
+        ASSERT_EQ(dots.size(), pool.size());
+        for (size_t k = 0; k < pool.size(); ++k)
+        {
+            double dot = frobeniusDot(r, others[k]);
+            EXPECT_NEAR(dots[k], dot, 1e-12 * std::abs(dot) + 1e-12);
+            EXPECT_NEAR(distances[k], frobeniusDistance(r, others[k]), 1e-12 * distances[k] + 1e-12);
+        }
+    }
+
+    MatrixView r(ref, 0, 0, 10, 10);
+    EXPECT_TRUE(frobeniusDots(r, std::vector<MatrixView>()).empty());
+    std::vector<MatrixView> mixed;
+    mixed.push_back(MatrixView(pool[0], 0, 0, 10, 10));
+    mixed.push_back(MatrixView(pool[1], 0, 0, 10, 11));
+    EXPECT_THROW(frobeniusDistances(r, mixed), std::invalid_argument);
+}
@@ -0,0 +1,74 @@
+#include "../include/gemv.hpp"
+#include "../include/rowKernels.hpp"
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+void scaleInto(double *y, size_t n, double beta)
+{
+	if (beta == 0)
+		std::fill(y, y + n, 0.0);
+	else if (beta != 1)
+		for (size_t i = 0; i < n; i++)
+			y[i] *= beta;
+}
+
+void gemvRows(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+	const double *x, double *y, double alpha, double beta, bool transposed)
+{
+	ThreadPool &pool = ThreadPool::instance();
+	if (!transposed)
+	{
+		pool.parallelFor(0, numRows, numCols, [&](size_t lo, size_t hi) {
+			for (size_t i = lo; i < hi; i++)
+			{
+				double d = alpha * dot(rows[startRow + i] + startCol, x, numCols);
+				y[i] = beta == 0 ? d : d + beta * y[i];
+			}
+		});
+		return;
+	}
+	pool.parallelFor(0, numCols, numRows, [&](size_t lo, size_t hi) {
+		scaleInto(y + lo, hi - lo, beta);
+		for (size_t i = 0; i < numRows; i++)
+			axpy(alpha * x[i], rows[startRow + i] + startCol + lo, y + lo, hi - lo);
+	});
+}
+
+void checkSizes(size_t rows, size_t cols, const std::vector<double>& x, std::vector<double>& y,
+	double beta, bool transposed)
+{
+	size_t inSize = transposed ? rows : cols;
+	size_t outSize = transposed ? cols : rows;
+	if (x.size() != inSize)
+		throw std::invalid_argument("gemv: x has the wrong size");
+	if (beta == 0)
+		y.resize(outSize);
+	else if (y.size() != outSize)
+		throw std::invalid_argument("gemv: y has the wrong size");
+}
+
+}
+
+void gemv(const MatrixView& a, const double *x, double *y, double alpha, double beta, bool transposed)
+{
+	gemvRows(a.matrix_ptr, a.getStartRow(), a.getStartCol(), a.getRows(), a.getCols(), x, y, alpha, beta, transposed);
+}
+
+void gemv(const MatrixView& a, const std::vector<double>& x, std::vector<double>& y,
+	double alpha, double beta, bool transposed)
+{
+	checkSizes(a.getRows(), a.getCols(), x, y, beta, transposed);
+	gemv(a, x.data(), y.data(), alpha, beta, transposed);
+}
+
+void gemv(const Matrix& a, const std::vector<double>& x, std::vector<double>& y,
+	double alpha, double beta, bool transposed)
+{
+	checkSizes(a.getRows(), a.getCols(), x, y, beta, transposed);
+	// a pending scale of a goes into alpha, the rows are read as stored
+	gemvRows(a.getRawMatrix(), 0, 0, a.getRows(), a.getCols(), x.data(), y.data(),
+		alpha * a.getPendingScale(), beta, transposed);
+}
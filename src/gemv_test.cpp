@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "../include/gemv.hpp"
+#include <cmath>
+
+/**
+ * @brief Test the normal and transposed matrix-vector products
+ *
+ * This test case verifies:
+ * 1. y = alpha * A * x + beta * y over a tile matches a reference loop
+ * 2. The transposed product matches the reference of A^T * x
+ * 3. With beta == 0, NaNs already in y are overwritten
+ * 4. Size mismatches throw std::invalid_argument
+ */
+TEST(GemvTest, NormalAndTransposed)
+{
+    Matrix m(9, 7);
+    for (size_t i = 0; i < 9; ++i)
+        for (size_t j = 0; j < 7; ++j)
+            m(i, j) = std::sin(i * 7.0 + j);
+    MatrixView a(m, 2, 1, 6, 5);
+
+    std::vector<double> x5 = {1, -2, 0.5, 3, -1};
+    std::vector<double> y6(6, 1.0);
+    gemv(a, x5, y6, 2.0, 0.5);
+    for (size_t i = 0; i < 6; ++i)
+    {
+        double ref = 0.5;
+        for (size_t j = 0; j < 5; ++j)
+            ref += 2.0 * a(i, j) * x5[j];
+        EXPECT_NEAR(y6[i], ref, 1e-12);
+    }
+
+    std::vector<double> x6 = {1, 2, 3, 4, 5, 6};
+    std::vector<double> y5(5, std::nan(""));
+    gemv(a, x6, y5, 1.0, 0.0, true);
+    for (size_t j = 0; j < 5; ++j)
+    {
+        double ref = 0;
+        for (size_t i = 0; i < 6; ++i)
+            ref += a(i, j) * x6[i];
+        EXPECT_NEAR(y5[j], ref, 1e-12);
+    }
+
+    std::vector<double> y;
+    gemv(m, std::vector<double>(7, 1.0), y);
+    ASSERT_EQ(y.size(), 9);
+    EXPECT_NEAR(y[0], std::sin(0.0) + std::sin(1.0) + std::sin(2.0) + std::sin(3.0)
+        + std::sin(4.0) + std::sin(5.0) + std::sin(6.0), 1e-12);
+
+    EXPECT_THROW(gemv(a, x6, y6), std::invalid_argument);
+    std::vector<double> bad(3);
+    EXPECT_THROW(gemv(a, x5, bad, 1.0, 1.0), std::invalid_argument);
+}
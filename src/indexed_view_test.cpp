@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../include/IndexedView.hpp"
+#include "test_matrices.hpp"
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Test row and column selections by index
+ *
+ * This test case verifies:
+ * 1. Selected rows and columns read the parent elements at the given indices, in the given order
+ * 2. Indices of a tile view are relative to the tile
+ * 3. Norms and gathered matrices match a copy made element by element, repeated indices included
+ * 4. Writes go to the parent and keep its cached norm exact
+ * 5. Out-of-range indices throw
+ */
+TEST(IndexedViewTest, Selection)
+{
+    Matrix m = filledMatrix(50, 40);
+    m.frobeniusNorm();
+    std::vector<size_t> rows = {7, 3, 3, 49, 0};
+    std::vector<size_t> cols = {39, 1, 20};
+
+    IndexedView view(m, rows, cols);
+    EXPECT_EQ(view.getRows(), 5u);
+    EXPECT_EQ(view.getCols(), 3u);
+    EXPECT_DOUBLE_EQ(view.getValue(0, 0), 739.0);
+    EXPECT_DOUBLE_EQ(view.getValue(3, 2), 4920.0);
+    double expected = 0;
+    for (size_t i = 0; i < rows.size(); ++i)
+        for (size_t j = 0; j < cols.size(); ++j)
+            expected += m.getValue(rows[i], cols[j]) * m.getValue(rows[i], cols[j]);
+    EXPECT_NEAR(view.frobeniusNorm(), std::sqrt(expected), 1e-12 * expected);
+    Matrix gathered = view;
+    EXPECT_DOUBLE_EQ(gathered.getValue(2, 1), 301.0);
+    EXPECT_NEAR(gathered.frobeniusNorm(), std::sqrt(expected), 1e-12 * expected);
+
+    view.setValue(1, 1, -5.0);
+    EXPECT_DOUBLE_EQ(m.getValue(3, 1), -5.0);
+    EXPECT_DOUBLE_EQ(view.getValue(2, 1), -5.0);
+    expected += 2 * (25.0 - 301.0 * 301.0);
+    EXPECT_NEAR(view.frobeniusNorm(), std::sqrt(expected), 1e-12 * expected);
+    double cached = m.frobeniusNorm();
+    m.setSumComputed(false);
+    EXPECT_NEAR(cached, m.frobeniusNorm(), 1e-12 * cached);
+
+    MatrixView tile(m, 10, 5, 20, 30);
+    IndexedView picked = IndexedView::selectRows(tile, {19, 0});
+    EXPECT_TRUE(picked.allColumns());
+    EXPECT_EQ(picked.getCols(), 30u);
+    EXPECT_EQ(picked.parentRow(0), 29u);
+    EXPECT_EQ(picked.parentCol(0), 5u);
+    EXPECT_DOUBLE_EQ(picked.getValue(1, 29), 1034.0);
+    IndexedView inner(tile, {1}, {2});
+    EXPECT_DOUBLE_EQ(inner.getValue(0, 0), 1107.0);
+
+    IndexedView columns = IndexedView::selectCols(m, {2, 2});
+    EXPECT_EQ(columns.getRows(), 50u);
+    EXPECT_DOUBLE_EQ(columns.getValue(49, 1), 4902.0);
+
+    EXPECT_THROW(IndexedView(m, {50}, {0}), std::out_of_range);
+    EXPECT_THROW(IndexedView(tile, {0}, {30}), std::out_of_range);
+    EXPECT_THROW(view.getValue(5, 0), std::out_of_range);
+}
+
+/**
+ * @brief Test permutation views
+ *
+ * This test case verifies:
+ * 1. Row, column and full permutations reorder the elements without copying them
+ * 2. A permutation of the whole matrix takes the parent's cached norm
+ * 3. A gathered row permutation of a large matrix matches the permuted rows
+ * 4. Index arrays that are not permutations are rejected
+ */
+TEST(IndexedViewTest, Permutations)
+{
+    Matrix m = filledMatrix(300, 70);
+    double norm = m.frobeniusNorm();
+    std::vector<size_t> rowPerm(300), colPerm(70);
+    for (size_t i = 0; i < 300; ++i)
+        rowPerm[i] = 299 - i;
+    for (size_t j = 0; j < 70; ++j)
+        colPerm[j] = (j * 3) % 70;
+
+    IndexedView rowsOnly = IndexedView::permuteRows(m, rowPerm);
+    EXPECT_DOUBLE_EQ(rowsOnly.frobeniusNorm(), norm);
+    Matrix flipped = rowsOnly.toMatrix();
+    for (size_t i = 0; i < 300; ++i)
+        for (size_t j = 0; j < 70; ++j)
+            ASSERT_DOUBLE_EQ(flipped.getValue(i, j), m.getValue(299 - i, j));
+    EXPECT_DOUBLE_EQ(flipped.frobeniusNorm(), norm);
+
+    IndexedView colsOnly = IndexedView::permuteCols(m, colPerm);
+    EXPECT_DOUBLE_EQ(colsOnly.getValue(4, 1), 403.0);
+    IndexedView both = IndexedView::permute(m, rowPerm, colPerm);
+    EXPECT_DOUBLE_EQ(both.getValue(0, 2), 29906.0);
+    EXPECT_DOUBLE_EQ(both.frobeniusNorm(), norm);
+
+    std::vector<size_t> repeated(70, 0);
+    EXPECT_THROW(IndexedView::permuteCols(m, repeated), std::invalid_argument);
+    EXPECT_THROW(IndexedView::permuteRows(m, {0, 1}), std::invalid_argument);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "../include/LayoutMatrix.hpp"
+#include "test_matrices.hpp"
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+template <typename Layout>
+void checkLayout(size_t rows, size_t cols)
+{
+    Layout layout(rows, cols);
+    std::set<size_t> offsets;
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+        {
+            size_t offset = layout.offset(i, j);
+            ASSERT_LT(offset, layout.size());
+            ASSERT_TRUE(offsets.insert(offset).second);
+        }
+
+    const size_t tiles[][4] = {{0, 0, rows, cols}, {3, 5, 17, 30}, {9, 1, 40, 1}, {20, 10, 1, 33}};
+    for (const auto &t : tiles)
+    {
+        std::multiset<size_t> expected, covered;
+        for (size_t i = t[0]; i < t[0] + t[2]; ++i)
+            for (size_t j = t[1]; j < t[1] + t[3]; ++j)
+                expected.insert(layout.offset(i, j));
+        layout.forEachSpan(t[0], t[1], t[2], t[3], [&](size_t first, size_t n) {
+            for (size_t k = 0; k < n; ++k)
+                covered.insert(first + k);
+        });
+        ASSERT_EQ(covered, expected);
+    }
+}
+
+template <typename Layout>
+void checkNorms(const Matrix &source)
+{
+    LayoutMatrix<Layout> m(source);
+    EXPECT_NEAR(m.frobeniusNorm(), source.frobeniusNorm(), 1e-12 * source.frobeniusNorm());
+    Matrix back = m.toMatrix();
+    for (size_t i = 0; i < source.getRows(); ++i)
+        for (size_t j = 0; j < source.getCols(); ++j)
+            ASSERT_EQ(back(i, j), source(i, j));
+
+    const size_t tiles[][4] = {{0, 0, 70, 45}, {3, 5, 60, 2}, {33, 0, 1, 45}, {10, 12, 41, 29}};
+    for (const auto &t : tiles)
+    {
+        LayoutMatrixView<Layout> tile = m.view(t[0], t[1], t[2], t[3]);
+        MatrixView expected(const_cast<Matrix &>(source), t[0], t[1], t[2], t[3]);
+        EXPECT_NEAR(tile.frobeniusNorm(), expected.frobeniusNorm(), 1e-12 * expected.frobeniusNorm());
+        EXPECT_EQ(tile.getValue(t[2] - 1, t[3] - 1), source(t[0] + t[2] - 1, t[1] + t[3] - 1));
+    }
+
+    m.setValue(69, 44, 10.0);
+    Matrix updated(source);
+    updated(69, 44) = 10.0;
+    EXPECT_NEAR(m.frobeniusNorm(), updated.frobeniusNorm(), 1e-12 * updated.frobeniusNorm());
+    EXPECT_THROW(m.getValue(70, 0), std::out_of_range);
+    EXPECT_THROW(m.view(60, 0, 11, 1), std::out_of_range);
+}
+
+}
+
+/**
+ * @brief Test the layout index maps
+ *
+ * This test case verifies:
+ * 1. Every layout maps the elements to distinct offsets inside its storage
+ * 2. The spans of a tile cover exactly the tile's elements, once each
+ * 3. Edge blocks of tiled layouts are handled when the size is not a multiple of the block
+ */
+TEST(LayoutMatrixTest, IndexMaps)
+{
+    checkLayout<RowMajorLayout>(70, 45);
+    checkLayout<ColumnMajorLayout>(70, 45);
+    checkLayout<BlockedLayout<8>>(70, 45);
+    checkLayout<MortonLayout<8>>(70, 45);
+    checkLayout<MortonLayout<32>>(70, 45);
+
+    MortonLayout<2> z(4, 4);
+    EXPECT_EQ(z.offset(0, 2), 4u);
+    EXPECT_EQ(z.offset(2, 0), 8u);
+    EXPECT_EQ(z.offset(3, 3), 15u);
+}
+
+/**
+ * @brief Test values and norms in every layout
+ *
+ * This test case verifies:
+ * 1. Conversion from and to Matrix preserves every element
+ * 2. Matrix and tile norms match the MatrixView norms of the same tiles
+ * 3. setValue keeps the cached norm in step
+ * 4. Out-of-range access and tiles throw
+ */
+TEST(LayoutMatrixTest, NormsAndValues)
+{
+    Matrix source = filledMatrix(70, 45, [](size_t i, size_t j) {
+        return std::cos(0.3 * i - 0.11 * j) + 0.01 * j;
+    });
+    checkNorms<RowMajorLayout>(source);
+    checkNorms<ColumnMajorLayout>(source);
+    checkNorms<BlockedLayout<16>>(source);
+    checkNorms<MortonLayout<8>>(source);
+}
@@ -0,0 +1,266 @@
+#include "../include/lowPrecision.hpp"
+#include <cstring>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+/*
+
+	Scalar conversions
+
+*/
+
+float toFloat(bfloat16 value)
+{
+	uint32_t bits = static_cast<uint32_t>(value.bits) << 16;
+	float f;
+	std::memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+bfloat16 toBFloat16(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	bfloat16 result;
+	// NaNs keep their sign and stay quiet instead of rounding to infinity
+	if ((bits & 0x7fffffffu) > 0x7f800000u)
+		result.bits = static_cast<uint16_t>((bits >> 16) | 0x40u);
+	else
+		result.bits = static_cast<uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+	return result;
+}
+
+float toFloat(float16 value)
+{
+#ifdef __F16C__
+	return _cvtsh_ss(value.bits);
+#else
+	uint32_t sign = static_cast<uint32_t>(value.bits & 0x8000u) << 16;
+	uint32_t exponent = (value.bits >> 10) & 0x1fu;
+	uint32_t mantissa = value.bits & 0x3ffu;
+	uint32_t bits;
+	if (exponent == 0)
+	{
+		// zero or subnormal, exact in float: mantissa * 2^-24
+		float f = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+		std::memcpy(&bits, &f, sizeof(bits));
+		bits |= sign;
+	}
+	else if (exponent == 0x1f)
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	else
+		bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+	float f;
+	std::memcpy(&f, &bits, sizeof(f));
+	return f;
+#endif
+}
+
+float16 toFloat16(float value)
+{
+	float16 result;
+#ifdef __F16C__
+	result.bits = _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	uint32_t sign = (bits >> 16) & 0x8000u;
+	uint32_t magnitude = bits & 0x7fffffffu;
+	if (magnitude >= 0x7f800000u)
+		result.bits = static_cast<uint16_t>(sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x200u : 0));
+	else if (magnitude >= 0x477ff000u)
+		// 65520 and above round to infinity
+		result.bits = static_cast<uint16_t>(sign | 0x7c00u);
+	else if (magnitude < 0x38800000u)
+	{
+		// below 2^-14: adding 0.5 leaves exactly the subnormal's bits in
+		// the low mantissa, rounded to nearest even by the FPU
+		float f;
+		std::memcpy(&f, &magnitude, sizeof(f));
+		f += 0.5f;
+		std::memcpy(&magnitude, &f, sizeof(magnitude));
+		result.bits = static_cast<uint16_t>(sign | (magnitude - 0x3f000000u));
+	}
+	else
+	{
+		// rebias the exponent from 127 to 15 and round the dropped 13 bits
+		magnitude += 0xc8000fffu + ((magnitude >> 13) & 1u);
+		result.bits = static_cast<uint16_t>(sign | (magnitude >> 13));
+	}
+#endif
+	return result;
+}
+
+/*
+
+	Norm kernels
+
+	Four elements are loaded and widened to float in one register, then
+	split into two double vectors. Two groups of four per iteration keep
+	four accumulators in flight.
+
+*/
+
+namespace {
+
+template <typename T>
+double scalarSumOfSquares(const T *row, size_t n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		double x0 = widen(row[j]), x1 = widen(row[j + 1]);
+		double x2 = widen(row[j + 2]), x3 = widen(row[j + 3]);
+		s0 += x0 * x0;
+		s1 += x1 * x1;
+		s2 += x2 * x2;
+		s3 += x3 * x3;
+	}
+	for (; j < n; j++)
+	{
+		double x = widen(row[j]);
+		s0 += x * x;
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+#ifdef __SSE2__
+
+inline void accumulate(__m128 x, __m128d &lo, __m128d &hi)
+{
+	__m128d a = _mm_cvtps_pd(x);
+	__m128d b = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+	lo = _mm_add_pd(lo, _mm_mul_pd(a, a));
+	hi = _mm_add_pd(hi, _mm_mul_pd(b, b));
+}
+
+inline __m128 load4(const float *p)
+{
+	return _mm_loadu_ps(p);
+}
+
+// a bfloat16 is the upper half of its float
+inline __m128 load4(const bfloat16 *p)
+{
+	__m128i bits = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+	return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), bits));
+}
+
+#ifdef __F16C__
+inline __m128 load4(const float16 *p)
+{
+	return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+}
+#endif
+
+template <typename T>
+double vectorSumOfSquares(const T *row, size_t n)
+{
+	__m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+	__m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+	size_t j = 0;
+	for (; j + 8 <= n; j += 8)
+	{
+		accumulate(load4(row + j), s0, s1);
+		accumulate(load4(row + j + 4), s2, s3);
+	}
+	__m128d total = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+	double lanes[2];
+	_mm_storeu_pd(lanes, total);
+	return lanes[0] + lanes[1] + scalarSumOfSquares(row + j, n - j);
+}
+
+#endif
+
+}
+
+double sumOfSquares(const float *row, size_t n)
+{
+#ifdef __SSE2__
+	return vectorSumOfSquares(row, n);
+#else
+	return scalarSumOfSquares(row, n);
+#endif
+}
+
+double sumOfSquares(const bfloat16 *row, size_t n)
+{
+#ifdef __SSE2__
+	return vectorSumOfSquares(row, n);
+#else
+	return scalarSumOfSquares(row, n);
+#endif
+}
+
+double sumOfSquares(const float16 *row, size_t n)
+{
+#if defined(__SSE2__) && defined(__F16C__)
+	return vectorSumOfSquares(row, n);
+#else
+	return scalarSumOfSquares(row, n);
+#endif
+}
+
+/*
+
+	Bulk conversions
+
+	Plain loops over bit patterns, which the compiler vectorises; fp16
+	uses the F16C conversions when the target has them.
+
+*/
+
+void widenSpan(double *dst, const float *src, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+		dst[j] = src[j];
+}
+
+void widenSpan(double *dst, const bfloat16 *src, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+		dst[j] = toFloat(src[j]);
+}
+
+void widenSpan(double *dst, const float16 *src, size_t n)
+{
+	size_t j = 0;
+#ifdef __F16C__
+	for (; j + 4 <= n; j += 4)
+	{
+		__m128 x = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + j)));
+		_mm_storeu_pd(dst + j, _mm_cvtps_pd(x));
+		_mm_storeu_pd(dst + j + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+	}
+#endif
+	for (; j < n; j++)
+		dst[j] = toFloat(src[j]);
+}
+
+void narrowSpan(float *dst, const double *src, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+		dst[j] = static_cast<float>(src[j]);
+}
+
+void narrowSpan(bfloat16 *dst, const double *src, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+		dst[j] = toBFloat16(static_cast<float>(src[j]));
+}
+
+void narrowSpan(float16 *dst, const double *src, size_t n)
+{
+	size_t j = 0;
+#ifdef __F16C__
+	for (; j + 4 <= n; j += 4)
+	{
+		__m128 x = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + j)), _mm_cvtpd_ps(_mm_loadu_pd(src + j + 2)));
+		_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT));
+	}
+#endif
+	for (; j < n; j++)
+		dst[j] = toFloat16(static_cast<float>(src[j]));
+}
@@ -6,6 +6,20 @@ int main() {
 		ft_listing_1();
 		ft_listing_2();
 		ft_listing_3();
+		ft_listing_4();
+		ft_listing_5();
+		ft_listing_6();
+		ft_listing_7();
+		ft_listing_8();
+		ft_listing_9();
+		ft_listing_10();
+		ft_listing_11();
+		ft_listing_12();
+		ft_listing_13();
+		ft_listing_14();
+		ft_listing_15();
+		ft_listing_16();
+		ft_listing_17();
 	
 	} catch (const std::exception &e) {
 		std::cout << "Exception: " << e.what() << std::endl;
@@ -0,0 +1,97 @@
+#include "../include/matrixAsync.hpp"
+#include "../include/rowKernels.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const size_t CANCEL_CHECK_ROWS = 64;
+
+double cancellableSumOfSquares(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+	const CancellationToken &token)
+{
+	double sum = 0;
+	for (size_t i = 0; i < numRows; i++)
+	{
+		if (i % CANCEL_CHECK_ROWS == 0)
+			token.throwIfCancelled();
+		sum += sumOfSquares(rows[startRow + i] + startCol, numCols);
+	}
+	return sum;
+}
+
+Matrix cancellableCopy(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+	const CancellationToken &token)
+{
+	Matrix tmp(numRows, numCols);
+	double **dst = tmp.getRawMatrix();
+	for (size_t i = 0; i < numRows; i++)
+	{
+		if (i % CANCEL_CHECK_ROWS == 0)
+			token.throwIfCancelled();
+		std::memcpy(dst[i], rows[startRow + i] + startCol, numCols * sizeof(double));
+	}
+	tmp.markWritten(0, numRows);
+	return tmp;
+}
+
+}
+
+/*
+	A cached sum of squares is used as is, otherwise the rows are scanned
+	on the pool. The scan does not write the cache back, the caller may
+	still be using the matrix. The cache and a pending scale are read on
+	the calling thread, the task only touches the rows as stored, so the
+	caller may compute the norm itself in the meantime.
+*/
+Future<double> frobeniusNormAsync(const Matrix& m)
+{
+	double **rows = m.getRawMatrix();
+	size_t numRows = m.getRows(), numCols = m.getCols();
+	double scale = m.getPendingScale();
+	bool sumComputed = m.getSumComputed();
+	double sum = m.getSum();
+	return runAsync([rows, numRows, numCols, scale, sumComputed, sum](CancellationToken token) {
+		if (sumComputed)
+			return std::sqrt(sum);
+		return std::fabs(scale) * std::sqrt(cancellableSumOfSquares(rows, 0, 0, numRows, numCols, token));
+	});
+}
+
+Future<double> frobeniusNormAsync(const MatrixView& view)
+{
+	MatrixView v(view);
+	return runAsync([v](CancellationToken token) {
+		if (v.sumComputed)
+			return std::sqrt(v.sum);
+		return std::sqrt(cancellableSumOfSquares(v.matrix_ptr, v.getStartRow(), v.getStartCol(), v.getRows(), v.getCols(), token));
+	});
+}
+
+// the copy takes the pending scale lazily, which is O(1) on a fresh matrix
+Future<Matrix> copyAsync(const Matrix& m)
+{
+	double **rows = m.getRawMatrix();
+	size_t numRows = m.getRows(), numCols = m.getCols();
+	double scale = m.getPendingScale();
+	bool sumComputed = m.getSumComputed();
+	double sum = m.getSum();
+	return runAsync([rows, numRows, numCols, scale, sumComputed, sum](CancellationToken token) {
+		Matrix tmp = cancellableCopy(rows, 0, 0, numRows, numCols, token);
+		tmp.scale(scale);
+		tmp.setSum(sum);
+		tmp.setSumComputed(sumComputed);
+		return tmp;
+	});
+}
+
+Future<Matrix> materializeAsync(const MatrixView& view)
+{
+	MatrixView v(view);
+	return runAsync([v](CancellationToken token) {
+		Matrix tmp = cancellableCopy(v.matrix_ptr, v.getStartRow(), v.getStartCol(), v.getRows(), v.getCols(), token);
+		tmp.setSum(v.sum);
+		tmp.setSumComputed(v.sumComputed);
+		return tmp;
+	});
+}
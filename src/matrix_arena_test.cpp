@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "../include/MatrixArena.hpp"
+#include <memory>
+
+/**
+ * @brief Test Matrix allocation inside arena scopes
+ *
+ * This test case verifies:
+ * 1. Matrices built inside a scope take their storage from the innermost arena
+ * 2. Arena storage starts zeroed and behaves like heap storage for copies, growth and reshape
+ * 3. Scopes nest and restore the enclosing scope when they close
+ * 4. Matrices and views that escape the scope keep their data
+ */
+TEST(MatrixArenaTest, ScopedAllocation)
+{
+    EXPECT_EQ(MatrixArena::current(), nullptr);
+    std::unique_ptr<Matrix> escaped;
+    std::unique_ptr<MatrixView> view;
+    {
+        MatrixArena outer(4096);
+        EXPECT_EQ(MatrixArena::current(), &outer);
+
+        Matrix zero(20, 30);
+        EXPECT_GT(outer.getUsed(), 20 * 30 * sizeof(double));
+        EXPECT_DOUBLE_EQ(zero.frobeniusNorm(), 0.0);
+        EXPECT_DOUBLE_EQ(zero(19, 29), 0.0);
+
+        Matrix filled(20, 30, 2.0);
+        zero(3, 4) = 5.0;
+        Matrix copy = zero;
+        EXPECT_DOUBLE_EQ(copy(3, 4), 5.0);
+        EXPECT_DOUBLE_EQ(copy.frobeniusNorm(), 5.0);
+        {
+            MatrixArena inner;
+            EXPECT_EQ(MatrixArena::current(), &inner);
+            size_t before = outer.getUsed();
+            Matrix tile = MatrixView(filled, 2, 3, 10, 10);
+            EXPECT_EQ(outer.getUsed(), before);
+            EXPECT_GE(inner.getUsed(), 100 * sizeof(double));
+            EXPECT_DOUBLE_EQ(tile.frobeniusNorm(), 20.0);
+        }
+        EXPECT_EQ(MatrixArena::current(), &outer);
+
+        filled.appendRow(std::vector<double>(30, 1.0));
+        filled.reshape(30, 21);
+        EXPECT_DOUBLE_EQ(filled(29, 20), 1.0);
+        EXPECT_DOUBLE_EQ(filled(0, 0), 2.0);
+
+        escaped.reset(new Matrix(50, 50, 3.0));
+        view.reset(new MatrixView(zero, 0, 0, 5, 5));
+    }
+    EXPECT_EQ(MatrixArena::current(), nullptr);
+    EXPECT_DOUBLE_EQ((*escaped)(49, 49), 3.0);
+    EXPECT_DOUBLE_EQ(escaped->frobeniusNorm(), 150.0);
+    EXPECT_DOUBLE_EQ((*view)(3, 4), 5.0);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../include/matrixAsync.hpp"
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * @brief Test the asynchronous norm and copy operations
+ *
+ * This test case verifies:
+ * 1. frobeniusNormAsync matches the synchronous norm for matrices and views
+ * 2. copyAsync returns an independent copy carrying the cached sum
+ * 3. materializeAsync returns the elements of the view
+ */
+TEST(MatrixAsyncTest, NormAndCopy)
+{
+    Matrix m(6, 5);
+    for (size_t i = 0; i < 6; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            m(i, j) = i * 5.0 + j;
+    MatrixView view(m, 1, 1, 3, 2);
+
+    Future<double> norm = frobeniusNormAsync(m);
+    Future<double> viewNorm = frobeniusNormAsync(view);
+    EXPECT_DOUBLE_EQ(norm.get(), m.frobeniusNorm());
+    EXPECT_DOUBLE_EQ(viewNorm.get(), view.frobeniusNorm());
+
+    Matrix copy = copyAsync(m).get();
+    EXPECT_EQ(copy.getRows(), 6);
+    EXPECT_EQ(copy.getCols(), 5);
+    copy(0, 0) = 100.0;
+    EXPECT_DOUBLE_EQ(m(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(copy(5, 4), 29.0);
+
+    Matrix tile = materializeAsync(view).get();
+    EXPECT_EQ(tile.getRows(), 3);
+    EXPECT_EQ(tile.getCols(), 2);
+    EXPECT_DOUBLE_EQ(tile(2, 1), m(3, 2));
+}
+
+/**
+ * @brief Test chaining of futures with then()
+ *
+ * This test case verifies:
+ * 1. A continuation receives the value of the previous stage
+ * 2. Errors propagate through the chain to get()
+ * 3. A continuation returning void gives a Future<void> that can be chained on
+ */
+TEST(MatrixAsyncTest, Chaining)
+{
+    Matrix m(4, 4, 2.0);
+    Future<double> squared = frobeniusNormAsync(m).then([](double norm) { return norm * norm; });
+    EXPECT_DOUBLE_EQ(squared.get(), 64.0);
+
+    Future<double> failing = materializeAsync(MatrixView(m, 0, 0, 2, 2))
+        .then([](Matrix) -> double { throw std::out_of_range("bad tile"); });
+    EXPECT_THROW(failing.get(), std::out_of_range);
+
+    double observed = 0;
+    Future<void> logged = frobeniusNormAsync(m).then([&observed](double norm) { observed = norm; });
+    logged.get();
+    EXPECT_DOUBLE_EQ(observed, 8.0);
+
+    Future<int> counted = frobeniusNormAsync(m).then([](double) {}).then([]() { return 7; });
+    EXPECT_EQ(counted.get(), 7);
+
+    Future<void> failingVoid = materializeAsync(MatrixView(m, 0, 0, 2, 2))
+        .then([](Matrix) { throw std::out_of_range("bad tile"); })
+        .then([&observed]() { observed = -1.0; });
+    EXPECT_THROW(failingVoid.get(), std::out_of_range);
+    EXPECT_DOUBLE_EQ(observed, 8.0);
+
+    runAsync([&observed](CancellationToken) { observed = 2.0; }).get();
+    EXPECT_DOUBLE_EQ(observed, 2.0);
+}
+
+/**
+ * @brief Test cancellation of a pending operation
+ *
+ * This test case verifies:
+ * 1. An operation cancelled before it runs reports OperationCancelled
+ * 2. Continuations of a cancelled operation are cancelled as well
+ */
+TEST(MatrixAsyncTest, Cancellation)
+{
+    ThreadPool &pool = ThreadPool::instance();
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    for (size_t i = 0; i < pool.getThreadCount(); ++i)
+    {
+        pool.submit([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]() { return release; });
+        });
+    }
+
+    Matrix m(64, 64, 1.0);
+    Future<double> norm = frobeniusNormAsync(m);
+    Future<double> chained = frobeniusNormAsync(m).then([](double n) { return n + 1; });
+    norm.cancel();
+    chained.cancel();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+
+    EXPECT_TRUE(norm.isCancelled());
+    EXPECT_THROW(norm.get(), OperationCancelled);
+    EXPECT_THROW(chained.get(), OperationCancelled);
+}
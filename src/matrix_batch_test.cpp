@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../include/MatrixBatch.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+double memberValue(size_t k, size_t i, size_t j)
+{
+    return std::sin(1.0 + k + 0.5 * i - 0.25 * j);
+}
+
+MatrixBatch filledBatch(size_t count, size_t rows, size_t cols)
+{
+    MatrixBatch batch(count, rows, cols);
+    for (size_t k = 0; k < count; ++k)
+    {
+        BatchMember m = batch.member(k);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                m(i, j) = memberValue(k, i, j);
+    }
+    return batch;
+}
+
+}
+
+/**
+ * @brief Test member access and batched norms
+ *
+ * This test case verifies:
+ * 1. Members are read and written in place, independently of each other
+ * 2. Conversion of a member to and from Matrix preserves its elements
+ * 3. frobeniusNorms matches the per-member and Matrix norms, including a partial last group
+ * 4. Out-of-range members, indices and mismatched shapes throw
+ */
+TEST(MatrixBatchTest, MembersAndNorms)
+{
+    const size_t count = 11, rows = 3, cols = 2;
+    MatrixBatch batch = filledBatch(count, rows, cols);
+    EXPECT_EQ(batch.getGroups(), 2u);
+
+    BatchMember fifth = batch.member(5);
+    EXPECT_DOUBLE_EQ(fifth.getValue(2, 1), memberValue(5, 2, 1));
+    fifth.setValue(2, 1, 4.0);
+    EXPECT_DOUBLE_EQ(batch.member(5)(2, 1), 4.0);
+    EXPECT_DOUBLE_EQ(batch.member(4)(2, 1), memberValue(4, 2, 1));
+
+    Matrix copy = fifth.toMatrix();
+    EXPECT_DOUBLE_EQ(copy(2, 1), 4.0);
+    EXPECT_DOUBLE_EQ(copy(0, 0), memberValue(5, 0, 0));
+    Matrix replacement(rows, cols, 2.0);
+    batch.member(10).assign(replacement);
+    EXPECT_DOUBLE_EQ(batch.member(10).frobeniusNorm(), std::sqrt(24.0));
+
+    std::vector<double> norms = batch.frobeniusNorms();
+    ASSERT_EQ(norms.size(), count);
+    for (size_t k = 0; k < count; ++k)
+    {
+        EXPECT_NEAR(norms[k], batch.member(k).frobeniusNorm(), 1e-14);
+        EXPECT_NEAR(norms[k], batch.member(k).toMatrix().frobeniusNorm(), 1e-14);
+    }
+
+    EXPECT_THROW(batch.member(count), std::out_of_range);
+    EXPECT_THROW(fifth.getValue(3, 0), std::out_of_range);
+    EXPECT_THROW(fifth.assign(Matrix(2, 3)), std::invalid_argument);
+}
+
+/**
+ * @brief Test the element-wise batch operations
+ *
+ * This test case verifies:
+ * 1. fill, scale, axpy, add and hadamard act on every member
+ * 2. Padding matrices of the last group do not leak into the results
+ * 3. Batches of different shapes are rejected
+ */
+TEST(MatrixBatchTest, ElementWise)
+{
+    const size_t count = 13, rows = 4, cols = 4;
+    MatrixBatch x = filledBatch(count, rows, cols);
+    MatrixBatch y(count, rows, cols, 1.0);
+
+    y.axpy(2.0, x);
+    y.add(x);
+    EXPECT_DOUBLE_EQ(y.member(12)(3, 1), 1.0 + 3.0 * memberValue(12, 3, 1));
+    y.scale(0.5);
+    EXPECT_DOUBLE_EQ(y.member(0)(0, 0), 0.5 * (1.0 + 3.0 * memberValue(0, 0, 0)));
+    y.hadamard(x);
+    EXPECT_DOUBLE_EQ(y.member(7)(2, 2), 0.5 * (1.0 + 3.0 * memberValue(7, 2, 2)) * memberValue(7, 2, 2));
+
+    y.fill(3.0);
+    std::vector<double> norms = y.frobeniusNorms();
+    for (size_t k = 0; k < count; ++k)
+        EXPECT_DOUBLE_EQ(norms[k], 12.0);
+
+    EXPECT_THROW(y.add(MatrixBatch(count, rows, cols + 1)), std::invalid_argument);
+    EXPECT_THROW(y.axpy(1.0, MatrixBatch(count + 1, rows, cols)), std::invalid_argument);
+}
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
 #include "../include/Matrix.hpp"
+#include "../include/apply.hpp"
+#include "../include/gemv.hpp"
+#include "../include/rowKernels.hpp"
+#include "../include/transpose.hpp"
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 /**
  * @brief Test the default constructor of the Matrix class
@@ -394,3 +401,380 @@ TEST(MatrixTest, StreamInsertionOperator)
     EXPECT_EQ(ss4.str(), "");
 }
 
+
+/**
+ * @brief Test appending rows to a Matrix
+ *
+ * This test case verifies:
+ * 1. Rows already on the heap keep their address while the matrix grows
+ * 2. appendRow and appendRows (from a Matrix and from a view) copy the values
+ * 3. The cached Frobenius sum is updated as rows arrive
+ * 4. Rows of the wrong width throw std::invalid_argument
+ */
+TEST(MatrixTest, AppendRows)
+{
+    Matrix m(2, 3, 1.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(6.0));
+
+    // the first growth moves a small matrix out of its inline buffer
+    m.reserveRows(4);
+    EXPECT_EQ(m.getRowCapacity(), 4u);
+    double *firstRow = m.getMatrix()[0];
+    m.appendRow(std::vector<double>{2.0, 2.0, 2.0});
+    for (int r = 0; r < 20; ++r)
+        m.appendRow(std::vector<double>{0.0, 0.0, 1.0});
+    EXPECT_EQ(m.getRows(), 23u);
+    EXPECT_GE(m.getRowCapacity(), 23u);
+    EXPECT_EQ(m.getMatrix()[0], firstRow);
+    EXPECT_DOUBLE_EQ(m.getValue(2, 1), 2.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(6.0 + 12.0 + 20.0));
+
+    Matrix block(2, 3, 3.0);
+    m.appendRows(block);
+    MatrixView head(m, 0, 0, 3, 3);
+    m.appendRows(head);
+    EXPECT_EQ(m.getRows(), 28u);
+    EXPECT_DOUBLE_EQ(m.getValue(24, 2), 3.0);
+    EXPECT_DOUBLE_EQ(m.getValue(27, 0), 2.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(38.0 + 54.0 + 18.0));
+
+    EXPECT_THROW(m.appendRow(std::vector<double>{1.0}), std::invalid_argument);
+    EXPECT_THROW(m.appendRows(Matrix(1, 4)), std::invalid_argument);
+}
+
+/**
+ * @brief Test resize and reshape of a Matrix
+ *
+ * This test case verifies:
+ * 1. resize keeps the overlapping elements and zero-fills new ones
+ * 2. The cached sum drops the removed rows and columns
+ * 3. reshape reinterprets the elements in row-major order without moving them
+ * 4. reshape with a different element count throws std::invalid_argument
+ */
+TEST(MatrixTest, ResizeAndReshape)
+{
+    Matrix m(3, 4);
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            m(i, j) = i * 4.0 + j;
+    double expected = 0;
+    for (int k = 0; k < 12; ++k)
+        expected += k * k;
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(expected));
+
+    double *data = m.getMatrix()[0];
+    m.reshape(2, 6);
+    EXPECT_EQ(m.getRows(), 2u);
+    EXPECT_EQ(m.getCols(), 6u);
+    EXPECT_EQ(m.getMatrix()[0], data);
+    EXPECT_DOUBLE_EQ(m.getValue(1, 0), 6.0);
+    EXPECT_DOUBLE_EQ(m.getValue(1, 5), 11.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(expected));
+    EXPECT_THROW(m.reshape(5, 2), std::invalid_argument);
+
+    m.resize(1, 6);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(0.0 + 1 + 4 + 9 + 16 + 25));
+    m.resize(3, 4);
+    EXPECT_DOUBLE_EQ(m.getValue(0, 3), 3.0);
+    EXPECT_DOUBLE_EQ(m.getValue(2, 3), 0.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(0.0 + 1 + 4 + 9));
+
+    // appended past the first block, reshape compacts once
+    m.appendRow(std::vector<double>{1.0, 1.0, 1.0, 1.0});
+    m.reshape(8, 2);
+    EXPECT_DOUBLE_EQ(m.getValue(1, 1), 3.0);
+    EXPECT_DOUBLE_EQ(m.getValue(7, 1), 1.0);
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), std::sqrt(0.0 + 1 + 4 + 9 + 4));
+}
+
+/**
+ * @brief Test bulk copies and materialization of views
+ *
+ * This test case verifies:
+ * 1. Copies carry the cached sum and its computed flag
+ * 2. Copy assignment into a matrix of the same width reuses its rows
+ * 3. A view larger than the streaming threshold materializes exactly
+ * 4. Streaming span copies handle unaligned starts and odd lengths
+ */
+TEST(MatrixTest, BulkCopy)
+{
+    Matrix a(30, 20, 2.0);
+    a.frobeniusNorm();
+    Matrix b(a);
+    EXPECT_TRUE(b.getSumComputed());
+    EXPECT_DOUBLE_EQ(b.getSum(), 4.0 * 600);
+
+    Matrix c(40, 20);
+    double *row0 = c.getMatrix()[0];
+    c = a;
+    EXPECT_EQ(c.getRows(), 30u);
+    EXPECT_EQ(c.getMatrix()[0], row0);
+    EXPECT_DOUBLE_EQ(c.getValue(29, 19), 2.0);
+    EXPECT_DOUBLE_EQ(c.frobeniusNorm(), a.frobeniusNorm());
+
+    const size_t n = 2100;
+    Matrix big(n, n);
+    for (size_t i = 0; i < n; i += 7)
+        for (size_t j = 0; j < n; j += 5)
+            big(i, j) = static_cast<double>(i) - j;
+    MatrixView v(big, 3, 1, n - 3, n - 1);
+    Matrix tile = v;
+    for (size_t i = 0; i < n - 3; i += 7)
+        for (size_t j = 0; j < n - 1; j += 5)
+            ASSERT_DOUBLE_EQ(tile.getValue(i, j), big.getValue(i + 3, j + 1));
+    Matrix again(n, n);
+    again = big;
+    EXPECT_DOUBLE_EQ(again.getValue(n - 1, n - 1), big.getValue(n - 1, n - 1));
+    EXPECT_DOUBLE_EQ(again.frobeniusNorm(), big.frobeniusNorm());
+
+    std::vector<double> src(37), dst(40, -1.0);
+    for (size_t j = 0; j < src.size(); ++j)
+        src[j] = j * 0.5;
+    copySpan(dst.data() + 1, src.data(), src.size(), true);
+    EXPECT_DOUBLE_EQ(dst[0], -1.0);
+    for (size_t j = 0; j < src.size(); ++j)
+        ASSERT_DOUBLE_EQ(dst[j + 1], src[j]);
+    EXPECT_DOUBLE_EQ(dst[38], -1.0);
+}
+
+/**
+ * @brief Test the lazily zeroed storage and its untouched-row tracking
+ *
+ * This test case verifies:
+ * 1. A new matrix reads as zeros and every row starts untouched
+ * 2. Writes through the matrix and through a view mark only their row group
+ * 3. Norms and copies that skip untouched groups stay exact
+ * 4. Copies keep the untouched groups of the source
+ * 5. Writes through getMatrix() are seen by norms and copies without markWritten()
+ * 6. A view materialized into a Matrix keeps the untouched groups of its parent
+ */
+TEST(MatrixTest, LazyZeroAllocation)
+{
+    const size_t rows = 20000, cols = 1000;
+    Matrix m(rows, cols);
+    EXPECT_DOUBLE_EQ(m.getValue(rows - 1, cols - 1), 0.0);
+    EXPECT_TRUE(m.isUntouched(0));
+    EXPECT_TRUE(m.isUntouched(rows - 1));
+    EXPECT_DOUBLE_EQ(m.frobeniusNorm(), 0.0);
+
+    m(130, 7) = 3.0;
+    MatrixView v(m, 9000, 0, 200, 10);
+    v(150, 2) = 4.0;
+    EXPECT_FALSE(m.isUntouched(130));
+    EXPECT_FALSE(m.isUntouched(9150));
+    EXPECT_TRUE(m.isUntouched(0));
+    EXPECT_TRUE(m.isUntouched(9000));
+
+    Matrix fresh(rows, cols);
+    fresh(130, 7) = 3.0;
+    fresh(9150, 2) = 4.0;
+    EXPECT_DOUBLE_EQ(fresh.frobeniusNorm(), 5.0);
+    MatrixView around(fresh, 100, 0, 9100, cols);
+    EXPECT_DOUBLE_EQ(around.frobeniusNorm(), 5.0);
+
+    Matrix copy(fresh);
+    EXPECT_TRUE(copy.isUntouched(5000));
+    EXPECT_FALSE(copy.isUntouched(130));
+    EXPECT_DOUBLE_EQ(copy.getValue(130, 7), 3.0);
+    EXPECT_DOUBLE_EQ(copy.getValue(9150, 2), 4.0);
+    copy.setSumComputed(false);
+    EXPECT_DOUBLE_EQ(copy.frobeniusNorm(), 5.0);
+
+    Matrix tile = MatrixView(fresh, 100, 2, 9100, 500);
+    EXPECT_EQ(tile.getRows(), 9100u);
+    EXPECT_TRUE(tile.isUntouched(4900));
+    EXPECT_FALSE(tile.isUntouched(30));
+    EXPECT_FALSE(tile.isUntouched(9050));
+    EXPECT_DOUBLE_EQ(tile.getValue(30, 5), 3.0);
+    EXPECT_DOUBLE_EQ(tile.getValue(9050, 0), 4.0);
+    EXPECT_DOUBLE_EQ(tile.getValue(4900, 0), 0.0);
+    tile.setSumComputed(false);
+    EXPECT_DOUBLE_EQ(tile.frobeniusNorm(), 5.0);
+
+    Matrix direct(1000, 100);
+    direct.getMatrix()[500][5] = 3.0;
+    EXPECT_FALSE(direct.isUntouched(500));
+    EXPECT_DOUBLE_EQ(direct.frobeniusNorm(), 3.0);
+    Matrix directCopy = direct;
+    EXPECT_DOUBLE_EQ(directCopy.getValue(500, 5), 3.0);
+}
+
+/**
+ * @brief Test inline storage of small matrices
+ *
+ * This test case verifies:
+ * 1. Moves and swap are noexcept, so std::vector growth moves matrices
+ * 2. Small matrices have no heap storage and survive copies, moves and vector growth
+ * 3. Swapping a small and a large matrix exchanges their contents
+ * 4. A view taken of a small matrix moves it to shared storage and outlives it
+ * 5. Reshape and growth of a small matrix keep its elements
+ */
+TEST(MatrixTest, SmallBufferAndMoves)
+{
+    static_assert(std::is_nothrow_move_constructible<Matrix>::value, "Matrix moves must be noexcept");
+    static_assert(std::is_nothrow_move_assignable<Matrix>::value, "Matrix moves must be noexcept");
+    static_assert(std::is_nothrow_swappable<Matrix>::value, "Matrix swap must be noexcept");
+
+    std::vector<Matrix> many;
+    for (int k = 0; k < 1000; ++k)
+    {
+        Matrix small(3, 3, 0.0);
+        small(1, 2) = k;
+        many.push_back(std::move(small));
+        EXPECT_EQ(small.getRows(), 0u);
+    }
+    for (int k = 0; k < 1000; ++k)
+    {
+        ASSERT_FALSE(many[k].getStorage());
+        ASSERT_DOUBLE_EQ(many[k].getValue(1, 2), k);
+    }
+
+    Matrix copy = many[7];
+    EXPECT_FALSE(copy.getStorage());
+    EXPECT_DOUBLE_EQ(copy(1, 2), 7.0);
+    copy = many[8];
+    EXPECT_DOUBLE_EQ(copy(1, 2), 8.0);
+
+    Matrix large(10, 10, 1.0);
+    swap(copy, large);
+    EXPECT_EQ(copy.getRows(), 10u);
+    EXPECT_DOUBLE_EQ(copy.frobeniusNorm(), 10.0);
+    EXPECT_EQ(large.getRows(), 3u);
+    EXPECT_DOUBLE_EQ(large(1, 2), 8.0);
+    EXPECT_DOUBLE_EQ(large.frobeniusNorm(), 8.0);
+
+    std::unique_ptr<Matrix> owner(new Matrix(2, 2, 0.5));
+    MatrixView v(*owner, 0, 0, 2, 2);
+    EXPECT_TRUE(owner->getStorage());
+    owner.reset();
+    EXPECT_DOUBLE_EQ(v(1, 1), 0.5);
+
+    Matrix shaped(2, 6);
+    for (size_t j = 0; j < 6; ++j)
+        shaped(1, j) = j;
+    shaped.reshape(4, 3);
+    EXPECT_DOUBLE_EQ(shaped(3, 2), 5.0);
+    shaped.appendRow(std::vector<double>{7.0, 8.0, 9.0});
+    EXPECT_DOUBLE_EQ(shaped(2, 0), 0.0);
+    EXPECT_DOUBLE_EQ(shaped(3, 1), 4.0);
+    EXPECT_DOUBLE_EQ(shaped(4, 2), 9.0);
+}
+
+/**
+ * @brief Test lazy scaling of a Matrix
+ *
+ * This test case verifies:
+ * 1. scale() keeps the factor aside and updates a computed norm in O(1)
+ * 2. getValue, the norm and gemv see the scaled elements before any materialization
+ * 3. Access to the rows, writes and copies materialize or carry the factor correctly
+ * 4. A matrix shared with a view and a factor out of range are scaled on the spot
+ */
+TEST(MatrixTest, LazyScale)
+{
+    Matrix m(100, 30);
+    for (size_t i = 0; i < 100; ++i)
+        for (size_t j = 0; j < 30; ++j)
+            m(i, j) = 0.01 * i - 0.02 * j;
+    double norm = m.frobeniusNorm();
+
+    m.scale(3.0);
+    m.scale(-0.5);
+    EXPECT_DOUBLE_EQ(m.getPendingScale(), -1.5);
+    EXPECT_DOUBLE_EQ(m.getRawMatrix()[7][4], 0.07 - 0.08);
+    EXPECT_DOUBLE_EQ(m.getValue(7, 4), -1.5 * (0.07 - 0.08));
+    EXPECT_NEAR(m.frobeniusNorm(), 1.5 * norm, 1e-12 * norm);
+
+    std::vector<double> x(30, 1.0), y;
+    gemv(m, x, y);
+    double expected = 0;
+    for (size_t j = 0; j < 30; ++j)
+        expected += m.getValue(9, j);
+    EXPECT_NEAR(y[9], expected, 1e-12);
+
+    Matrix copy(m);
+    EXPECT_DOUBLE_EQ(copy.getPendingScale(), -1.5);
+    EXPECT_DOUBLE_EQ(copy.getValue(99, 0), -1.5 * 0.99);
+    m.setSumComputed(false);
+    EXPECT_NEAR(m.frobeniusNorm(), 1.5 * norm, 1e-12 * norm);
+
+    m(0, 0) = 2.0;
+    EXPECT_DOUBLE_EQ(m.getPendingScale(), 1.0);
+    EXPECT_DOUBLE_EQ(m.getMatrix()[7][4], -1.5 * (0.07 - 0.08));
+    EXPECT_NEAR(m.frobeniusNorm(), std::sqrt(2.25 * norm * norm + 4.0), 1e-12 * norm);
+    EXPECT_DOUBLE_EQ(copy(99, 0), -1.5 * 0.99);
+    EXPECT_DOUBLE_EQ(copy.getPendingScale(), 1.0);
+
+    Matrix small(3, 3, 2.0);
+    small.scale(0.25);
+    small.appendRow(std::vector<double>{1.0, 1.0, 1.0});
+    EXPECT_DOUBLE_EQ(small(2, 2), 0.5);
+    EXPECT_DOUBLE_EQ(small.frobeniusNorm(), std::sqrt(9 * 0.25 + 3.0));
+
+    MatrixView v(copy, 0, 0, 10, 10);
+    copy.scale(2.0);
+    EXPECT_DOUBLE_EQ(copy.getPendingScale(), 1.0);
+    EXPECT_DOUBLE_EQ(static_cast<double>(v(9, 0)), -3.0 * 0.09);
+
+    Matrix tiny(2, 2, 1.0);
+    tiny.scale(std::ldexp(1.0, 200));
+    tiny.scale(std::ldexp(1.0, 200));
+    EXPECT_DOUBLE_EQ(tiny.getPendingScale(), 1.0);
+    EXPECT_DOUBLE_EQ(tiny.getRawMatrix()[1][1], std::ldexp(1.0, 400));
+    tiny.scale(0.0);
+    EXPECT_DOUBLE_EQ(tiny.frobeniusNorm(), 0.0);
+}
+
+/**
+ * @brief Test the readers of a lazily scaled const Matrix
+ *
+ * This test case verifies:
+ * 1. transpose, transform and appendRows see the scaled elements
+ * 2. operator() and getMatrix() on the const matrix apply or leave the factor
+ * 3. The source keeps its pending factor, its rows are not written,
+ *    also with several threads reading at once
+ */
+TEST(MatrixTest, LazyScaleConstReaders)
+{
+    Matrix m(40, 3);
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            m(i, j) = i + 0.5 * j;
+    m.scale(-2.0);
+    const Matrix &cm = m;
+
+    Matrix t = transpose(cm);
+    EXPECT_DOUBLE_EQ(t.getValue(2, 39), -2.0 * 40.0);
+    EXPECT_NEAR(t.frobeniusNorm(), cm.frobeniusNorm(), 1e-12 * cm.frobeniusNorm());
+
+    Matrix squared(40, 3);
+    transform(cm, squared, [](double x) { return x * x; });
+    EXPECT_DOUBLE_EQ(squared.getValue(10, 1), 4.0 * 10.5 * 10.5);
+
+    Matrix grown(1, 3, 1.0);
+    grown.appendRows(cm);
+    EXPECT_EQ(grown.getRows(), 41u);
+    EXPECT_DOUBLE_EQ(grown.getValue(40, 2), -2.0 * 40.0);
+    EXPECT_NEAR(grown.frobeniusNorm(), std::sqrt(3.0 + cm.frobeniusNorm() * cm.frobeniusNorm()), 1e-9);
+
+    EXPECT_DOUBLE_EQ(cm(39, 2), -2.0 * 40.0);
+    EXPECT_DOUBLE_EQ(cm.getMatrix()[39][2] * cm.getPendingScale(), -2.0 * 40.0);
+    std::vector<double> totals(4, 0.0);
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < totals.size(); ++t)
+        readers.emplace_back([&cm, &totals, t]() {
+            for (size_t i = 0; i < 40; ++i)
+                totals[t] += cm(i, 0);
+        });
+    for (size_t t = 0; t < readers.size(); ++t)
+    {
+        readers[t].join();
+        EXPECT_DOUBLE_EQ(totals[t], -2.0 * 780.0);
+    }
+
+    EXPECT_DOUBLE_EQ(cm.getPendingScale(), -2.0);
+    EXPECT_DOUBLE_EQ(cm.getRawMatrix()[39][2], 40.0);
+
+    m.appendRows(cm);
+    EXPECT_DOUBLE_EQ(m.getValue(79, 2), -2.0 * 40.0);
+    EXPECT_DOUBLE_EQ(m.getValue(39, 2), -2.0 * 40.0);
+}
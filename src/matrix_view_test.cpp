@@ -431,4 +431,59 @@ TEST(MatrixViewTest, FrobeniusNorm)
 
     view3.updateValueAndSum(5.0, 0, 0);
     EXPECT_NE(view3.frobeniusNorm(), norm);
-}
\ No newline at end of file
+}
+/**
+ * @brief Test that a view keeps its rows alive
+ *
+ * This test case verifies:
+ * 1. A view still reads its data after the matrix is destroyed
+ * 2. A view made before the matrix grows keeps reading the same rows
+ */
+TEST(MatrixViewTest, ViewOutlivesMatrix)
+{
+    Matrix *m = new Matrix(10, 4);
+    (*m)(2, 3) = 1.4;
+    MatrixView v(*m, 1, 2, 2, 2);
+    delete m;
+    EXPECT_DOUBLE_EQ(static_cast<double>(v(1, 1)), 1.4);
+    Matrix copy = v;
+    EXPECT_DOUBLE_EQ(copy(1, 1), 1.4);
+
+    Matrix grown(2, 2, 1.0);
+    MatrixView before(grown, 0, 0, 2, 2);
+    for (int i = 0; i < 100; ++i)
+        grown.appendRow(std::vector<double>{2.0, 2.0});
+    grown(1, 1) = 5.0;
+    EXPECT_DOUBLE_EQ(static_cast<double>(before(1, 1)), 5.0);
+}
+
+/**
+ * @brief Test scaling a tile through its view
+ *
+ * This test case verifies:
+ * 1. Only the elements of the tile are scaled, in the parent too
+ * 2. The view's norm and the parent's cached norm follow without a rescan
+ * 3. Untouched row groups of the parent stay zero
+ */
+TEST(MatrixViewTest, Scale)
+{
+    Matrix m(200, 20);
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 20; ++j)
+            m(i, j) = 1.0 + i + j;
+    double before = m.getSum();
+    MatrixView tile(m, 2, 5, 150, 10);
+    double tileSum = tile.frobeniusNorm() * tile.frobeniusNorm();
+
+    tile.scale(-2.0);
+    EXPECT_DOUBLE_EQ(m.getValue(2, 5), -2.0 * 8.0);
+    EXPECT_DOUBLE_EQ(m.getValue(2, 4), 7.0);
+    EXPECT_DOUBLE_EQ(m.getValue(9, 15), 25.0);
+    EXPECT_NEAR(tile.frobeniusNorm(), 2.0 * std::sqrt(tileSum), 1e-12 * tileSum);
+    EXPECT_NEAR(m.getSum(), before + 3.0 * tileSum, 1e-12 * before);
+    EXPECT_TRUE(m.isUntouched(150));
+    EXPECT_DOUBLE_EQ(m.getValue(151, 5), 0.0);
+
+    m.setSumComputed(false);
+    EXPECT_NEAR(m.frobeniusNorm(), std::sqrt(before + 3.0 * tileSum), 1e-12 * before);
+}
@@ -0,0 +1,25 @@
+#include "../include/reduce.hpp"
+
+namespace {
+
+template <typename Source>
+TileStatistics allStatistics(const Source &source)
+{
+	TileStatistics s;
+	std::tie(s.sum, s.mean, s.variance, s.min, s.max, s.l1, s.maxAbs, s.frobenius) =
+		reduce(source, SumReducer(), MeanReducer(), VarianceReducer(), MinReducer(), MaxReducer(),
+			L1Reducer(), MaxAbsReducer(), FrobeniusReducer());
+	return s;
+}
+
+}
+
+TileStatistics statistics(const MatrixView &view)
+{
+	return allStatistics(view);
+}
+
+TileStatistics statistics(const Matrix &m)
+{
+	return allStatistics(m);
+}
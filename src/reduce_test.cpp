@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "../include/axisReductions.hpp"
+#include "../include/reduce.hpp"
+#include <cmath>
+
+/**
+ * @brief Test the fused reductions over a MatrixView
+ *
+ * This test case verifies:
+ * 1. Every built-in reducer returns the expected statistic
+ * 2. The Frobenius reducer agrees with MatrixView::frobeniusNorm
+ * 3. Results come back in argument order
+ */
+TEST(ReduceTest, BuiltInReducers)
+{
+    Matrix m(4, 5);
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            m(i, j) = (i * 5.0 + j) - 7.0;
+    MatrixView view(m, 1, 1, 2, 3);  // -1 0 1 / 4 5 6
+
+    double sum, mean, variance, lo, hi, l1, maxAbs, frob;
+    std::tie(sum, mean, variance, lo, hi, l1, maxAbs, frob) =
+        reduce(view, SumReducer(), MeanReducer(), VarianceReducer(), MinReducer(),
+               MaxReducer(), L1Reducer(), MaxAbsReducer(), FrobeniusReducer());
+
+    EXPECT_DOUBLE_EQ(sum, 15.0);
+    EXPECT_DOUBLE_EQ(mean, 2.5);
+    EXPECT_DOUBLE_EQ(variance, (12.25 + 6.25 + 2.25 + 2.25 + 6.25 + 12.25) / 6.0);
+    EXPECT_DOUBLE_EQ(lo, -1.0);
+    EXPECT_DOUBLE_EQ(hi, 6.0);
+    EXPECT_DOUBLE_EQ(l1, 17.0);
+    EXPECT_DOUBLE_EQ(maxAbs, 6.0);
+    EXPECT_DOUBLE_EQ(frob, view.frobeniusNorm());
+
+    std::tuple<double, double> pair = reduce(view, MaxReducer(), SumReducer());
+    EXPECT_DOUBLE_EQ(std::get<0>(pair), 6.0);
+    EXPECT_DOUBLE_EQ(std::get<1>(pair), 15.0);
+}
+
+/**
+ * @brief Test reductions over a whole, wide Matrix
+ *
+ * This test case verifies:
+ * 1. Rows longer than one span are reduced correctly
+ * 2. The variance stays accurate for data with a large offset
+ * 3. statistics() returns all values from one call
+ */
+TEST(ReduceTest, WideMatrixStatistics)
+{
+    Matrix m(30, 1000);
+    for (size_t i = 0; i < 30; ++i)
+        for (size_t j = 0; j < 1000; ++j)
+            m(i, j) = 1e8 + ((i + j) % 2 == 0 ? 1.0 : -1.0);
+
+    TileStatistics s = statistics(m);
+    EXPECT_NEAR(s.mean, 1e8, 1e-6);
+    EXPECT_NEAR(s.variance, 1.0, 1e-9);
+    EXPECT_DOUBLE_EQ(s.min, 1e8 - 1);
+    EXPECT_DOUBLE_EQ(s.max, 1e8 + 1);
+    EXPECT_NEAR(s.frobenius, m.frobeniusNorm(), 1e-6);
+}
+
+/**
+ * @brief Test reductions over a lazily scaled Matrix
+ *
+ * This test case verifies:
+ * 1. reduce() and the axis norms see the scaled elements
+ * 2. Reading through a const Matrix leaves the factor pending
+ */
+TEST(ReduceTest, PendingScale)
+{
+    Matrix m(20, 600);
+    for (size_t i = 0; i < 20; ++i)
+        for (size_t j = 0; j < 600; ++j)
+            m(i, j) = 0.5 * i - 0.01 * j;
+    Matrix expected(m);
+    m.scale(-2.0);
+    ASSERT_DOUBLE_EQ(m.getPendingScale(), -2.0);
+    const Matrix &cm = m;
+
+    double lo, hi, frob;
+    std::tie(lo, hi, frob) = reduce(cm, MinReducer(), MaxReducer(), FrobeniusReducer());
+    EXPECT_DOUBLE_EQ(lo, -2.0 * 9.5);
+    EXPECT_DOUBLE_EQ(hi, 2.0 * 5.99);
+    EXPECT_NEAR(frob, 2.0 * expected.frobeniusNorm(), 1e-9);
+
+    std::vector<double> rows, cols;
+    rowNorms(cm, rows);
+    colNorms(cm, cols);
+    EXPECT_NEAR(rows[3], 2.0 * MatrixView(expected, 3, 0, 1, 600).frobeniusNorm(), 1e-9);
+    EXPECT_NEAR(cols[7], 2.0 * MatrixView(expected, 0, 7, 20, 1).frobeniusNorm(), 1e-9);
+    EXPECT_DOUBLE_EQ(m.getPendingScale(), -2.0);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../include/RingMatrix.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+double pushedValue(size_t t, size_t j)
+{
+    return std::sin(0.37 * t + j) * (1.0 + t % 5);
+}
+
+}
+
+/**
+ * @brief Test that the ring keeps the newest rows in logical order
+ *
+ * This test case verifies:
+ * 1. Before wrapping, rows are stored in push order
+ * 2. After wrapping, the oldest rows are overwritten and row 0 is the oldest kept
+ * 3. Logical views cross the physical wrap point transparently
+ * 4. Out-of-range access and wrongly sized rows throw
+ * 5. Views are read-only, the rows behind the running sums cannot be written
+ */
+TEST(RingMatrixTest, LogicalOrderAndViews)
+{
+    static_assert(!std::is_constructible<MatrixView, ConstMatrixView>::value,
+        "a ring view must not convert to a MatrixView");
+
+    RingMatrix ring(4, 3);
+    EXPECT_THROW(ring.windowNorm(1), std::out_of_range);
+    for (size_t t = 0; t < 3; ++t)
+        ring.push(std::vector<double>{double(t), double(t) + 0.5, double(t) + 0.25});
+    EXPECT_EQ(ring.getRows(), 3u);
+    EXPECT_FALSE(ring.isFull());
+    EXPECT_DOUBLE_EQ(ring.getValue(2, 1), 2.5);
+
+    for (size_t t = 3; t < 7; ++t)
+        ring.push(std::vector<double>{double(t), double(t) + 0.5, double(t) + 0.25});
+    EXPECT_TRUE(ring.isFull());
+    EXPECT_EQ(ring.getRows(), 4u);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_DOUBLE_EQ(ring.getValue(i, 0), 3.0 + i);
+
+    ConstMatrixView v = ring.view(1, 1, 3, 2);
+    EXPECT_DOUBLE_EQ(v(0, 0), 4.5);
+    EXPECT_DOUBLE_EQ(v(2, 1), 6.25);
+    EXPECT_DOUBLE_EQ(v.frobeniusNorm(),
+        std::sqrt(4.5 * 4.5 + 4.25 * 4.25 + 5.5 * 5.5 + 5.25 * 5.25 + 6.5 * 6.5 + 6.25 * 6.25));
+
+    EXPECT_THROW(ring.getValue(4, 0), std::out_of_range);
+    EXPECT_THROW(ring.view(2, 0, 3, 3), std::out_of_range);
+    EXPECT_THROW(ring.push(std::vector<double>{1.0}), std::invalid_argument);
+    EXPECT_THROW(RingMatrix(0, 3), std::invalid_argument);
+}
+
+/**
+ * @brief Test the rolling window norms over a long stream
+ *
+ * This test case verifies:
+ * 1. The full-buffer norm matches a rescan of the stored rows after every push
+ * 2. Windows of any length over the newest rows match a rescan
+ * 3. Accuracy holds after many wraps and rebases
+ */
+TEST(RingMatrixTest, RollingNorms)
+{
+    const size_t capacity = 50, cols = 16;
+    RingMatrix ring(capacity, cols);
+    std::vector<double> row(cols);
+    for (size_t t = 0; t < 5000; ++t)
+    {
+        for (size_t j = 0; j < cols; ++j)
+            row[j] = pushedValue(t, j);
+        ring.push(row);
+
+        if (t % 97 != 0 && t != 4999)
+            continue;
+        size_t stored = ring.getRows();
+        EXPECT_NEAR(ring.frobeniusNorm(), ring.view().frobeniusNorm(), 1e-9);
+        for (size_t length : {size_t(1), size_t(7), stored})
+        {
+            if (length > stored)
+                continue;
+            double expected = ring.view(stored - length, 0, length, cols).frobeniusNorm();
+            ASSERT_NEAR(ring.windowNorm(length), expected, 1e-9 * (1 + expected));
+        }
+    }
+
+    ring.clear();
+    EXPECT_EQ(ring.getRows(), 0u);
+    EXPECT_DOUBLE_EQ(ring.frobeniusNorm(), 0.0);
+}
@@ -0,0 +1,272 @@
+#include "../include/rowKernels.hpp"
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
+/*
+	Four independent accumulators break the add dependency chain and let
+	the compiler keep them in vector registers.
+*/
+double sumOfSquares(const double *row, size_t n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		s0 += row[j] * row[j];
+		s1 += row[j + 1] * row[j + 1];
+		s2 += row[j + 2] * row[j + 2];
+		s3 += row[j + 3] * row[j + 3];
+	}
+	for (; j < n; j++)
+		s0 += row[j] * row[j];
+	return (s0 + s1) + (s2 + s3);
+}
+
+double dot(const double *a, const double *b, size_t n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		s0 += a[j] * b[j];
+		s1 += a[j + 1] * b[j + 1];
+		s2 += a[j + 2] * b[j + 2];
+		s3 += a[j + 3] * b[j + 3];
+	}
+	for (; j < n; j++)
+		s0 += a[j] * b[j];
+	return (s0 + s1) + (s2 + s3);
+}
+
+double squaredDistance(const double *a, const double *b, size_t n, double alpha, double beta)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		double d0 = alpha * a[j] - beta * b[j];
+		double d1 = alpha * a[j + 1] - beta * b[j + 1];
+		double d2 = alpha * a[j + 2] - beta * b[j + 2];
+		double d3 = alpha * a[j + 3] - beta * b[j + 3];
+		s0 += d0 * d0;
+		s1 += d1 * d1;
+		s2 += d2 * d2;
+		s3 += d3 * d3;
+	}
+	for (; j < n; j++)
+	{
+		double d = alpha * a[j] - beta * b[j];
+		s0 += d * d;
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+void axpy(double alpha, const double *x, double *y, size_t n)
+{
+	for (size_t j = 0; j < n; j++)
+		y[j] += alpha * x[j];
+}
+
+// one read and one write per element, the old squares come with the read
+double scaleSpan(double *row, size_t n, double alpha)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		s0 += row[j] * row[j];
+		s1 += row[j + 1] * row[j + 1];
+		s2 += row[j + 2] * row[j + 2];
+		s3 += row[j + 3] * row[j + 3];
+		row[j] *= alpha;
+		row[j + 1] *= alpha;
+		row[j + 2] *= alpha;
+		row[j + 3] *= alpha;
+	}
+	for (; j < n; j++)
+	{
+		s0 += row[j] * row[j];
+		row[j] *= alpha;
+	}
+	return (s0 + s1) + (s2 + s3);
+}
+
+double sumOfSquares(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols)
+{
+	return ThreadPool::instance().parallelReduce(startRow, startRow + numRows, numCols, 0.0,
+		[rows, startCol, numCols](size_t lo, size_t hi) {
+			double sum = 0;
+			for (size_t i = lo; i < hi; i++)
+				sum += sumOfSquares(rows[i] + startCol, numCols);
+			return sum;
+		}, std::plus<double>());
+}
+
+double scaleTile(double **rows, size_t startRow, size_t startCol, size_t numRows, size_t numCols, double alpha)
+{
+	return ThreadPool::instance().parallelReduce(startRow, startRow + numRows, numCols, 0.0,
+		[rows, startCol, numCols, alpha](size_t lo, size_t hi) {
+			double sum = 0;
+			for (size_t i = lo; i < hi; i++)
+				sum += scaleSpan(rows[i] + startCol, numCols, alpha);
+			return sum;
+		}, std::plus<double>());
+}
+
+/*
+	The streaming path stores scalars until dst is vector aligned, then
+	whole vectors with non-temporal stores. Callers issue the fence.
+*/
+void copySpan(double *dst, const double *src, size_t n, bool streaming)
+{
+#ifdef __SSE2__
+	if (streaming)
+	{
+		size_t j = 0;
+#ifdef __AVX__
+		for (; j < n && (reinterpret_cast<uintptr_t>(dst + j) & 31) != 0; j++)
+			dst[j] = src[j];
+		for (; j + 4 <= n; j += 4)
+			_mm256_stream_pd(dst + j, _mm256_loadu_pd(src + j));
+#else
+		for (; j < n && (reinterpret_cast<uintptr_t>(dst + j) & 15) != 0; j++)
+			dst[j] = src[j];
+		for (; j + 2 <= n; j += 2)
+			_mm_stream_pd(dst + j, _mm_loadu_pd(src + j));
+#endif
+		for (; j < n; j++)
+			dst[j] = src[j];
+		return;
+	}
+#else
+	(void)streaming;
+#endif
+	std::memcpy(dst, src, n * sizeof(double));
+}
+
+void copyRows(double **dst, double **src, size_t numRows, size_t numCols, bool freshDestination)
+{
+	copyTile(dst, src, 0, 0, numRows, numCols, freshDestination);
+}
+
+void copyTile(double **dst, double **src, size_t startRow, size_t startCol, size_t numRows, size_t numCols,
+	bool freshDestination)
+{
+	bool streaming = !freshDestination && numRows * numCols * sizeof(double) >= STREAMING_COPY_BYTES;
+	ThreadPool::instance().parallelFor(0, numRows, numCols, [=](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+			copySpan(dst[i], src[startRow + i] + startCol, numCols, streaming);
+#ifdef __SSE2__
+		// non-temporal stores are weakly ordered, publish them before the chunk completes
+		if (streaming)
+			_mm_sfence();
+#endif
+	});
+}
+
+void fillRows(double **rows, size_t numRows, size_t numCols, double value)
+{
+	ThreadPool::instance().parallelFor(0, numRows, numCols, [rows, numCols, value](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+			std::fill(rows[i], rows[i] + numCols, value);
+	});
+}
+
+/*
+	Gather
+
+	Only the first few lines of a contiguous row are prefetched, the rest
+	follows as a stream. Indexed elements are scattered, so each one of
+	the row ahead is prefetched alongside the matching element of the
+	current row.
+
+*/
+
+namespace {
+
+const size_t PREFETCH_LINES = 4;
+const size_t LINE_DOUBLES = 8;
+
+inline void prefetchRead(const double *p)
+{
+#if defined(__GNUC__)
+	__builtin_prefetch(p, 0, 3);
+#else
+	(void)p;
+#endif
+}
+
+inline void prefetchHead(const double *row, size_t n)
+{
+	for (size_t l = 0; l < PREFETCH_LINES && l * LINE_DOUBLES < n; l++)
+		prefetchRead(row + l * LINE_DOUBLES);
+}
+
+}
+
+double gatherSumOfSquares(double *const *rows, size_t numRows, const size_t *cols, size_t numCols)
+{
+	return ThreadPool::instance().parallelReduce(0, numRows, numCols, 0.0,
+		[rows, numRows, cols, numCols](size_t lo, size_t hi) {
+			double sum = 0;
+			for (size_t i = lo; i < hi; i++)
+			{
+				const double *row = rows[i];
+				const double *ahead = i + PREFETCH_ROWS < numRows ? rows[i + PREFETCH_ROWS] : NULL;
+				if (cols == NULL)
+				{
+					if (ahead != NULL)
+						prefetchHead(ahead, numCols);
+					sum += sumOfSquares(row, numCols);
+					continue;
+				}
+				double s0 = 0, s1 = 0;
+				size_t k = 0;
+				for (; k + 2 <= numCols; k += 2)
+				{
+					if (ahead != NULL)
+					{
+						prefetchRead(ahead + cols[k]);
+						prefetchRead(ahead + cols[k + 1]);
+					}
+					double x0 = row[cols[k]], x1 = row[cols[k + 1]];
+					s0 += x0 * x0;
+					s1 += x1 * x1;
+				}
+				for (; k < numCols; k++)
+					s0 += row[cols[k]] * row[cols[k]];
+				sum += s0 + s1;
+			}
+			return sum;
+		}, std::plus<double>());
+}
+
+void gatherRows(double **dst, double *const *rows, size_t numRows, const size_t *cols, size_t numCols)
+{
+	ThreadPool::instance().parallelFor(0, numRows, numCols, [=](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+		{
+			const double *row = rows[i];
+			const double *ahead = i + PREFETCH_ROWS < numRows ? rows[i + PREFETCH_ROWS] : NULL;
+			if (cols == NULL)
+			{
+				if (ahead != NULL)
+					prefetchHead(ahead, numCols);
+				std::memcpy(dst[i], row, numCols * sizeof(double));
+				continue;
+			}
+			for (size_t k = 0; k < numCols; k++)
+			{
+				if (ahead != NULL)
+					prefetchRead(ahead + cols[k]);
+				dst[i][k] = row[cols[k]];
+			}
+		}
+	});
+}
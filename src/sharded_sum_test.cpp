@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "../include/Matrix.hpp"
+#include "../include/ShardedSum.hpp"
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Test the ShardedSum accumulator
+ *
+ * This test case verifies:
+ * 1. Deltas added from several threads are all accounted for
+ * 2. Threads beyond the shard count fall back to the overflow shard
+ * 3. reset() clears every shard
+ */
+TEST(ShardedSumTest, AddFromThreads)
+{
+    ShardedSum sum(2);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t)
+    {
+        threads.emplace_back([&sum]() {
+            for (int i = 0; i < 1000; ++i)
+                sum.add(0.5);
+        });
+    }
+    for (std::thread &t : threads)
+        t.join();
+    EXPECT_DOUBLE_EQ(sum.total(), 3000.0);
+
+    sum.reset();
+    EXPECT_DOUBLE_EQ(sum.total(), 0.0);
+}
+
+/**
+ * @brief Test the concurrent-write mode of the Matrix class
+ *
+ * This test case verifies:
+ * 1. Rows filled in parallel through operator() keep the incremental norm exact
+ * 2. The combined norm matches a full rescan of the data
+ * 3. Disabling the mode folds the partial sums back into the matrix sum
+ */
+TEST(ShardedSumTest, MatrixConcurrentFill)
+{
+    Matrix m(64, 32, 1.0);
+    m.enableConcurrentWrites(3);
+    EXPECT_TRUE(m.isConcurrentWrites());
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&m, t]() {
+            for (size_t i = t; i < m.getRows(); i += 4)
+                for (size_t j = 0; j < m.getCols(); ++j)
+                    m(i, j) = static_cast<double>(i + j) * 0.25;
+        });
+    }
+    for (std::thread &t : threads)
+        t.join();
+
+    double expected = 0;
+    for (size_t i = 0; i < m.getRows(); ++i)
+        for (size_t j = 0; j < m.getCols(); ++j)
+            expected += m.getValue(i, j) * m.getValue(i, j);
+    EXPECT_NEAR(m.frobeniusNorm(), std::sqrt(expected), 1e-9);
+
+    m.disableConcurrentWrites();
+    EXPECT_FALSE(m.isConcurrentWrites());
+    EXPECT_NEAR(m.frobeniusNorm(), std::sqrt(expected), 1e-9);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../include/SparseMatrix.hpp"
+#include "../include/gemv.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// about one entry in seven is non-zero
+Matrix sparseDense(size_t rows, size_t cols)
+{
+    Matrix m(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            if ((i * 31 + j * 17) % 7 == 0)
+                m(i, j) = static_cast<double>(i) - 0.5 * j;
+    return m;
+}
+
+}
+
+/**
+ * @brief Test conversion between Matrix, CSR and CSC
+ *
+ * This test case verifies:
+ * 1. Only the non-zero entries are stored
+ * 2. Every element reads back the same in both formats and after toDense
+ * 3. The stored norm equals the dense norm
+ * 4. Inconsistent compressed arrays throw std::invalid_argument
+ */
+TEST(SparseMatrixTest, DenseRoundTrip)
+{
+    Matrix dense = sparseDense(40, 57);
+    SparseMatrix csr(dense);
+    SparseMatrix csc(dense, SparseMatrix::CSC);
+
+    size_t nonZeros = 0;
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 57; ++j)
+        {
+            nonZeros += dense.getValue(i, j) != 0;
+            ASSERT_DOUBLE_EQ(csr.getValue(i, j), dense.getValue(i, j));
+            ASSERT_DOUBLE_EQ(csc.getValue(i, j), dense.getValue(i, j));
+        }
+    EXPECT_EQ(csr.getNonZeros(), nonZeros);
+    EXPECT_EQ(csc.getNonZeros(), nonZeros);
+    EXPECT_EQ(csc.getOffsets().size(), 58u);
+
+    Matrix back = csc.convert(SparseMatrix::CSR).toDense();
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 57; ++j)
+            ASSERT_DOUBLE_EQ(back.getValue(i, j), dense.getValue(i, j));
+    EXPECT_NEAR(csr.frobeniusNorm(), dense.frobeniusNorm(), 1e-9);
+    EXPECT_NEAR(back.frobeniusNorm(), dense.frobeniusNorm(), 1e-9);
+
+    EXPECT_THROW(SparseMatrix(2, 2, SparseMatrix::CSR, {0, 1, 2}, {1, 2}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(SparseMatrix(2, 2, SparseMatrix::CSR, {0, 2, 2}, {1, 0}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(csr.view(30, 50, 11, 5), std::out_of_range);
+}
+
+/**
+ * @brief Test norms over sparse tiles
+ *
+ * This test case verifies:
+ * 1. A tile norm matches the dense MatrixView norm in both formats
+ * 2. Tiles touching the matrix edges and empty tiles are handled
+ * 3. The tile non-zero count and toDense agree with the dense tile
+ */
+TEST(SparseMatrixTest, TileNorms)
+{
+    Matrix dense = sparseDense(120, 90);
+    SparseMatrix csr(dense);
+    SparseMatrix csc(dense, SparseMatrix::CSC);
+
+    const size_t tiles[][4] = {{0, 0, 120, 90}, {13, 7, 50, 61}, {100, 80, 20, 10}, {5, 5, 0, 0}, {60, 0, 1, 90}};
+    for (const auto &t : tiles)
+    {
+        MatrixView dv(dense, t[0], t[1], t[2], t[3]);
+        SparseMatrixView rv = csr.view(t[0], t[1], t[2], t[3]);
+        SparseMatrixView cv = csc.view(t[0], t[1], t[2], t[3]);
+        double expected = dv.frobeniusNorm();
+        EXPECT_NEAR(rv.frobeniusNorm(), expected, 1e-9);
+        EXPECT_NEAR(cv.frobeniusNorm(), expected, 1e-9);
+        EXPECT_EQ(rv.getNonZeros(), cv.getNonZeros());
+
+        Matrix tile = cv.toDense();
+        for (size_t i = 0; i < t[2]; ++i)
+            for (size_t j = 0; j < t[3]; ++j)
+                ASSERT_DOUBLE_EQ(tile.getValue(i, j), dense.getValue(t[0] + i, t[1] + j));
+        EXPECT_NEAR(tile.frobeniusNorm(), expected, 1e-9);
+    }
+}
+
+/**
+ * @brief Test sparse matrix-vector products
+ *
+ * This test case verifies:
+ * 1. CSR and CSC products over a tile match the dense gemv
+ * 2. alpha and beta are applied
+ * 3. A wrongly sized x throws std::invalid_argument
+ */
+TEST(SparseMatrixTest, SpMV)
+{
+    Matrix dense = sparseDense(300, 200);
+    SparseMatrix csr(dense);
+    SparseMatrix csc(dense, SparseMatrix::CSC);
+
+    std::vector<double> x(150);
+    for (size_t j = 0; j < x.size(); ++j)
+        x[j] = std::cos(0.1 * j);
+    MatrixView dv(dense, 20, 30, 250, 150);
+    std::vector<double> expected(250, 1.0);
+    gemv(dv, x, expected, 2.0, 0.5);
+
+    std::vector<double> yr(250, 1.0), yc(250, 1.0);
+    spmv(csr.view(20, 30, 250, 150), x, yr, 2.0, 0.5);
+    spmv(csc.view(20, 30, 250, 150), x, yc, 2.0, 0.5);
+    for (size_t i = 0; i < 250; ++i)
+    {
+        ASSERT_NEAR(yr[i], expected[i], 1e-9);
+        ASSERT_NEAR(yc[i], expected[i], 1e-9);
+    }
+
+    std::vector<double> full(200, 1.0), y;
+    spmv(csc, full, y);
+    ASSERT_EQ(y.size(), 300u);
+    double rowSum = 0;
+    for (size_t j = 0; j < 200; ++j)
+        rowSum += dense.getValue(3, j);
+    EXPECT_NEAR(y[3], rowSum, 1e-9);
+    EXPECT_THROW(spmv(csr, x, y), std::invalid_argument);
+}
@@ -0,0 +1,204 @@
+#include "../include/spectralNorm.hpp"
+#include "../include/gemv.hpp"
+#include "../include/rowKernels.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/*
+	Fixed pseudo-random start so results are reproducible; all-ones could
+	be orthogonal to the leading singular vector.
+*/
+void startVector(std::vector<double>& v)
+{
+	unsigned long long state = 88172645463325252ULL;
+	for (size_t i = 0; i < v.size(); i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		v[i] = static_cast<double>(state >> 11) / 9007199254740992.0 - 0.5;
+	}
+}
+
+double norm2(const std::vector<double>& v)
+{
+	return std::sqrt(sumOfSquares(v.data(), v.size()));
+}
+
+void scale(std::vector<double>& v, double factor)
+{
+	for (size_t i = 0; i < v.size(); i++)
+		v[i] *= factor;
+}
+
+// v -= (v . q) q for every stored q
+void orthogonalise(std::vector<double>& v, const std::vector<std::vector<double>>& basis)
+{
+	for (size_t k = 0; k < basis.size(); k++)
+		axpy(-dot(v.data(), basis[k].data(), v.size()), basis[k].data(), v.data(), v.size());
+}
+
+/*
+	Eigenvalues of a small dense symmetric matrix, cyclic Jacobi sweeps.
+*/
+std::vector<double> symmetricEigenvalues(std::vector<std::vector<double>> a)
+{
+	size_t n = a.size();
+	for (size_t sweep = 0; sweep < 100; sweep++)
+	{
+		double off = 0;
+		for (size_t p = 0; p < n; p++)
+			for (size_t q = p + 1; q < n; q++)
+				off += a[p][q] * a[p][q];
+		if (off < 1e-30)
+			break;
+		for (size_t p = 0; p < n; p++)
+		{
+			for (size_t q = p + 1; q < n; q++)
+			{
+				if (a[p][q] == 0)
+					continue;
+				double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+				double t = (theta >= 0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+				double c = 1 / std::sqrt(t * t + 1), s = t * c;
+				for (size_t k = 0; k < n; k++)
+				{
+					double akp = a[k][p], akq = a[k][q];
+					a[k][p] = c * akp - s * akq;
+					a[k][q] = s * akp + c * akq;
+				}
+				for (size_t k = 0; k < n; k++)
+				{
+					double apk = a[p][k], aqk = a[q][k];
+					a[p][k] = c * apk - s * aqk;
+					a[q][k] = s * apk + c * aqk;
+				}
+			}
+		}
+	}
+	std::vector<double> values(n);
+	for (size_t i = 0; i < n; i++)
+		values[i] = a[i][i];
+	return values;
+}
+
+}
+
+SpectralEstimate spectralNormEstimate(const MatrixView& view, double tol, size_t maxIter,
+	const std::vector<double>& warmStart)
+{
+	size_t cols = view.getCols();
+	SpectralEstimate result = {0, 0, false, std::vector<double>(cols)};
+	std::vector<double>& v = result.rightVector;
+	if (view.getRows() == 0 || cols == 0)
+	{
+		result.converged = true;
+		return result;
+	}
+
+	if (warmStart.size() == cols && norm2(warmStart) > 0)
+		v = warmStart;
+	else
+		startVector(v);
+	scale(v, 1 / norm2(v));
+
+	std::vector<double> u(view.getRows());
+	double previous = 0;
+	for (result.iterations = 1; result.iterations <= maxIter; result.iterations++)
+	{
+		gemv(view, v.data(), u.data());
+		result.value = norm2(u);
+		if (result.value == 0)
+		{
+			result.converged = true;
+			break;
+		}
+		gemv(view, u.data(), v.data(), 1.0, 0.0, true);
+		scale(v, 1 / norm2(v));
+		if (std::fabs(result.value - previous) <= tol * result.value)
+		{
+			result.converged = true;
+			break;
+		}
+		previous = result.value;
+	}
+	result.iterations = std::min(result.iterations, maxIter);
+	return result;
+}
+
+double spectralNormEstimate(const MatrixView& view, double tol, size_t maxIter)
+{
+	return spectralNormEstimate(view, tol, maxIter, std::vector<double>()).value;
+}
+
+/*
+	A v_j = alpha_j u_j + beta_{j-1} u_{j-1}: B is upper bidiagonal with
+	alpha on the diagonal and beta above it. Both bases are fully reorthogonalised, which keeps the small
+	problem accurate for the step counts used here.
+*/
+double nuclearNormEstimate(const MatrixView& view, size_t steps)
+{
+	size_t rows = view.getRows(), cols = view.getCols();
+	steps = std::min(steps, std::min(rows, cols));
+	if (steps == 0)
+		return 0;
+
+	std::vector<std::vector<double>> us, vs;
+	std::vector<double> alpha, beta;
+	std::vector<double> v(cols), u(rows);
+	startVector(v);
+	scale(v, 1 / norm2(v));
+
+	for (size_t j = 0; j < steps; j++)
+	{
+		vs.push_back(v);
+		gemv(view, v.data(), u.data());
+		if (j > 0)
+			axpy(-beta.back(), us.back().data(), u.data(), rows);
+		orthogonalise(u, us);
+		double a = norm2(u);
+		if (a <= 1e-14)
+			break;
+		scale(u, 1 / a);
+		alpha.push_back(a);
+		us.push_back(u);
+
+		gemv(view, u.data(), v.data(), 1.0, 0.0, true);
+		axpy(-a, vs.back().data(), v.data(), cols);
+		orthogonalise(v, vs);
+		double b = norm2(v);
+		if (b <= 1e-14)
+			break;
+		beta.push_back(b);
+		if (j + 1 == steps)
+			break;
+		scale(v, 1 / b);
+	}
+
+	/*
+		U_k^T A V_{k+1} = B, k x (k + 1) when the last beta was kept.
+		Its singular values are the square roots of the eigenvalues of B B^T.
+	*/
+	size_t k = alpha.size();
+	size_t m = beta.size() >= k ? k + 1 : k;
+	std::vector<std::vector<double>> b(k, std::vector<double>(m, 0.0));
+	for (size_t i = 0; i < k; i++)
+	{
+		b[i][i] = alpha[i];
+		if (i < beta.size())
+			b[i][i + 1] = beta[i];
+	}
+	std::vector<std::vector<double>> bbt(k, std::vector<double>(k, 0.0));
+	for (size_t i = 0; i < k; i++)
+		for (size_t j = 0; j < k; j++)
+			for (size_t c = 0; c < m; c++)
+				bbt[i][j] += b[i][c] * b[j][c];
+
+	std::vector<double> eigen = symmetricEigenvalues(bbt);
+	double nuclear = 0;
+	for (size_t i = 0; i < k; i++)
+		nuclear += std::sqrt(std::max(0.0, eigen[i]));
+	return nuclear;
+}
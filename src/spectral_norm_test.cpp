@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "../include/spectralNorm.hpp"
+#include <cmath>
+
+/**
+ * @brief Test the spectral norm estimate
+ *
+ * This test case verifies:
+ * 1. The estimate of a diagonal tile is its largest absolute entry
+ * 2. The estimate of a rank-one tile equals its Frobenius norm
+ * 3. Warm-starting from the previous result converges in fewer iterations
+ * 4. An all-zero tile returns 0
+ */
+TEST(SpectralNormTest, PowerIteration)
+{
+    Matrix d(6, 6);
+    d(0, 0) = 1.0; d(1, 1) = -5.0; d(2, 2) = 3.0; d(3, 3) = 4.5; d(4, 4) = 2.0; d(5, 5) = 0.5;
+    MatrixView dv(d, 0, 0, 6, 6);
+    EXPECT_NEAR(spectralNormEstimate(dv, 1e-10, 1000), 5.0, 1e-6);
+
+    Matrix r(8, 5);
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            r(i, j) = (i + 1.0) * (j - 2.5);
+    MatrixView rv(r, 0, 0, 8, 5);
+    EXPECT_NEAR(spectralNormEstimate(rv), rv.frobeniusNorm(), 1e-9);
+
+    SpectralEstimate cold = spectralNormEstimate(dv, 1e-10, 1000, std::vector<double>());
+    EXPECT_TRUE(cold.converged);
+    SpectralEstimate warm = spectralNormEstimate(dv, 1e-10, 1000, cold.rightVector);
+    EXPECT_TRUE(warm.converged);
+    EXPECT_LT(warm.iterations, cold.iterations);
+    EXPECT_NEAR(warm.value, 5.0, 1e-6);
+
+    Matrix z(4, 4);
+    EXPECT_DOUBLE_EQ(spectralNormEstimate(MatrixView(z, 0, 0, 4, 4)), 0.0);
+}
+
+/**
+ * @brief Test the nuclear norm estimate
+ *
+ * This test case verifies:
+ * 1. With enough steps the estimate of a diagonal tile is the sum of |d_i|
+ * 2. The estimate of a rank-one tile equals its Frobenius norm
+ * 3. Fewer steps than the rank give a lower bound
+ */
+TEST(SpectralNormTest, NuclearNorm)
+{
+    Matrix d(6, 7);
+    d(0, 0) = 1.0; d(1, 1) = -5.0; d(2, 2) = 3.0; d(3, 3) = 4.5; d(4, 4) = 2.0; d(5, 5) = 0.5;
+    MatrixView dv(d, 0, 0, 6, 7);
+    EXPECT_NEAR(nuclearNormEstimate(dv), 16.0, 1e-8);
+    EXPECT_LE(nuclearNormEstimate(dv, 2), 16.0 + 1e-12);
+
+    Matrix r(8, 5);
+    for (size_t i = 0; i < 8; ++i)
+        for (size_t j = 0; j < 5; ++j)
+            r(i, j) = (i + 1.0) * (j - 2.5);
+    MatrixView rv(r, 0, 0, 8, 5);
+    EXPECT_NEAR(nuclearNormEstimate(rv), rv.frobeniusNorm(), 1e-8);
+}
@@ -0,0 +1,29 @@
+#ifndef TEST_MATRICES_HPP
+#define TEST_MATRICES_HPP
+
+#include "../include/Matrix.hpp"
+#include <cstddef>
+
+/*
+	Matrices shared by the *_test.cpp files.
+
+	filledMatrix(rows, cols, value) sets element (i, j) to value(i, j).
+	Without a formula element (i, j) is i * 100 + j, so a misplaced
+	element names its own position in a failure message.
+*/
+template <typename F>
+Matrix filledMatrix(size_t rows, size_t cols, F value)
+{
+    Matrix m(rows, cols);
+    for (size_t i = 0; i < rows; ++i)
+        for (size_t j = 0; j < cols; ++j)
+            m(i, j) = value(i, j);
+    return m;
+}
+
+inline Matrix filledMatrix(size_t rows, size_t cols)
+{
+    return filledMatrix(rows, cols, [](size_t i, size_t j) { return i * 100.0 + j; });
+}
+
+#endif
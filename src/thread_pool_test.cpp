@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "../include/ThreadPool.hpp"
+#include "../include/frobeniusNorm.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Test parallelFor and parallelReduce of the ThreadPool class
+ *
+ * This test case verifies:
+ * 1. Every index is visited exactly once
+ * 2. Nested parallelFor calls from inside workers complete
+ * 3. parallelReduce combines the chunks into the exact total
+ * 4. Work below the serial cutoff runs on the calling thread
+ */
+TEST(ThreadPoolTest, ParallelFor)
+{
+    ThreadPool::Config config;
+    config.threads = 4;
+    config.serialCutoff = 1;
+    ThreadPool pool(config);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(0, visits.size(), 1, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            visits[i]++;
+    });
+    for (size_t i = 0; i < visits.size(); ++i)
+        EXPECT_EQ(visits[i].load(), 1);
+
+    std::atomic<size_t> inner(0);
+    pool.parallelFor(0, 8, 1, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i)
+            pool.parallelFor(0, 100, 1, [&](size_t a, size_t b) { inner += b - a; });
+    });
+    EXPECT_EQ(inner.load(), 800);
+
+    long total = pool.parallelReduce(0, 10001, 1, 0L, [](size_t lo, size_t hi) {
+        long s = 0;
+        for (size_t i = lo; i < hi; ++i)
+            s += i;
+        return s;
+    }, std::plus<long>());
+    EXPECT_EQ(total, 50005000L);
+
+    config.serialCutoff = 1000000;
+    pool.configure(config);
+    std::thread::id caller = std::this_thread::get_id();
+    pool.parallelFor(0, 100, 1, [&](size_t, size_t) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+    });
+}
+
+/**
+ * @brief Test an exception thrown inside parallelFor
+ *
+ * This test case verifies:
+ * 1. The exception reaches the caller whether the caller or a worker threw it
+ * 2. No chunk is still running when parallelFor returns
+ * 3. parallelReduce propagates it the same way and the pool stays usable
+ */
+TEST(ThreadPoolTest, ParallelForException)
+{
+    ThreadPool::Config config;
+    config.threads = 4;
+    config.serialCutoff = 1;
+    ThreadPool pool(config);
+
+    for (size_t bad = 0; bad < 16; bad += 5)
+    {
+        std::atomic<int> running(0);
+        EXPECT_THROW(pool.parallelFor(0, 16, 1, [&](size_t lo, size_t hi) {
+            running++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            running--;
+            if (lo <= bad && bad < hi)
+                throw std::runtime_error("chunk failed");
+        }), std::runtime_error);
+        EXPECT_EQ(running.load(), 0);
+    }
+
+    EXPECT_THROW(pool.parallelReduce(0, 100, 1, 0, [](size_t lo, size_t) -> int {
+        if (lo > 50)
+            throw std::out_of_range("chunk failed");
+        return 1;
+    }, std::plus<int>()), std::out_of_range);
+
+    std::atomic<size_t> visited(0);
+    pool.parallelFor(0, 100, 1, [&](size_t lo, size_t hi) { visited += hi - lo; });
+    EXPECT_EQ(visited.load(), 100);
+}
+
+/**
+ * @brief Test the configuration of the ThreadPool class
+ *
+ * This test case verifies:
+ * 1. The environment variables are read into the configuration
+ * 2. configure() restarts the pool with a new thread count
+ * 3. Submitted tasks all run before wait() returns
+ * 4. A throwing task does not stop the pool, wait() rethrows its exception once
+ */
+TEST(ThreadPoolTest, Configuration)
+{
+    setenv("MATRIX_THREADS", "3", 1);
+    setenv("MATRIX_SPIN", "10", 1);
+    setenv("MATRIX_SERIAL_CUTOFF", "123", 1);
+    ThreadPool::Config config = ThreadPool::Config::fromEnvironment();
+    EXPECT_EQ(config.threads, 3);
+    EXPECT_EQ(config.spinIterations, 10);
+    EXPECT_EQ(config.serialCutoff, 123);
+    unsetenv("MATRIX_THREADS");
+    unsetenv("MATRIX_SPIN");
+    unsetenv("MATRIX_SERIAL_CUTOFF");
+
+    ThreadPool pool(config);
+    EXPECT_EQ(pool.getThreadCount(), 3);
+    config.threads = 2;
+    pool.configure(config);
+    EXPECT_EQ(pool.getThreadCount(), 2);
+
+    std::atomic<int> ran(0);
+    for (int i = 0; i < 50; ++i)
+        pool.submit([&ran]() { ran++; });
+    pool.wait();
+    EXPECT_EQ(ran.load(), 50);
+
+    for (int i = 0; i < 10; ++i)
+        pool.submit([&ran, i]() {
+            if (i % 3 == 0)
+                throw std::runtime_error("task failed");
+            ran++;
+        });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(ran.load(), 56);
+    pool.submit([&ran]() { ran++; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(ran.load(), 57);
+}
+
+/**
+ * @brief Test the parallel norm paths on the shared pool
+ *
+ * This test case verifies:
+ * 1. A large matrix norm computed in parallel matches the exact value
+ * 2. Batched tile norms match the norms of the individual views
+ */
+TEST(ThreadPoolTest, ParallelNorms)
+{
+    ThreadPool::Config config = ThreadPool::instance().getConfig();
+    config.threads = 4;
+    config.serialCutoff = 1024;
+    ThreadPool::instance().configure(config);
+
+    Matrix m(300, 200, 0.5);
+    m.setSumComputed(false);
+    EXPECT_NEAR(m.frobeniusNorm(), std::sqrt(0.25 * 300 * 200), 1e-9);
+
+    Matrix copy(m);
+    EXPECT_DOUBLE_EQ(copy(299, 199), 0.5);
+
+    std::vector<MatrixView> views;
+    for (size_t i = 0; i < 20; ++i)
+        views.push_back(MatrixView(m, i, i, 100, 50));
+    std::vector<double> norms = frobeniusNorms(views);
+    ASSERT_EQ(norms.size(), 20);
+    for (size_t i = 0; i < norms.size(); ++i)
+        EXPECT_NEAR(norms[i], std::sqrt(0.25 * 100 * 50), 1e-9);
+}
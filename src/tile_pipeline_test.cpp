@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "../include/TilePipeline.hpp"
+#include <cmath>
+
+/**
+ * @brief Test the TilePipeline class
+ *
+ * This test case verifies:
+ * 1. Tiles below the watermark run while later rows are still unfilled
+ * 2. Tiles above the watermark wait until their rows are published
+ * 3. Every tile norm matches the norm of a MatrixView over the filled matrix
+ * 4. Invalid tiles are rejected with std::out_of_range
+ */
+TEST(TilePipelineTest, TilesFollowWatermark)
+{
+    ThreadPool pool(2);
+    Matrix m(8, 4);
+    TilePipeline pipeline(m, pool);
+
+    size_t late = pipeline.submit(4, 0, 4, 4);
+    for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            m(i, j) = 1.0;
+    pipeline.publishRows(4);
+    EXPECT_EQ(pipeline.getRowsReady(), 4);
+
+    size_t early = pipeline.submit(0, 0, 4, 4);
+    EXPECT_DOUBLE_EQ(pipeline.result(early), 4.0);
+
+    for (size_t i = 4; i < 8; ++i)
+        for (size_t j = 0; j < 4; ++j)
+            m(i, j) = 2.0;
+    pipeline.finish();
+    EXPECT_DOUBLE_EQ(pipeline.result(late), 8.0);
+
+    size_t whole = pipeline.submit(0, 0, 8, 4);
+    std::vector<double> norms = pipeline.results();
+    EXPECT_EQ(norms.size(), 3);
+    EXPECT_DOUBLE_EQ(norms[whole], MatrixView(m, 0, 0, 8, 4).frobeniusNorm());
+
+    EXPECT_THROW(pipeline.submit(6, 0, 4, 4), std::out_of_range);
+}
@@ -0,0 +1,197 @@
+#include "../include/transpose.hpp"
+#include "../include/ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const size_t BLOCK = 32;
+
+/*
+	d[c][r] = s[r][c] for the 4x4 quad at s[0..3] + col -> d[0..3] + row.
+*/
+inline void transpose4x4(const double *const *s, size_t col, double *const *d, size_t row)
+{
+#ifdef __AVX__
+	__m256d r0 = _mm256_loadu_pd(s[0] + col);
+	__m256d r1 = _mm256_loadu_pd(s[1] + col);
+	__m256d r2 = _mm256_loadu_pd(s[2] + col);
+	__m256d r3 = _mm256_loadu_pd(s[3] + col);
+	__m256d t0 = _mm256_unpacklo_pd(r0, r1);
+	__m256d t1 = _mm256_unpackhi_pd(r0, r1);
+	__m256d t2 = _mm256_unpacklo_pd(r2, r3);
+	__m256d t3 = _mm256_unpackhi_pd(r2, r3);
+	_mm256_storeu_pd(d[0] + row, _mm256_permute2f128_pd(t0, t2, 0x20));
+	_mm256_storeu_pd(d[1] + row, _mm256_permute2f128_pd(t1, t3, 0x20));
+	_mm256_storeu_pd(d[2] + row, _mm256_permute2f128_pd(t0, t2, 0x31));
+	_mm256_storeu_pd(d[3] + row, _mm256_permute2f128_pd(t1, t3, 0x31));
+#else
+	double q[4][4];
+	for (size_t r = 0; r < 4; r++)
+		for (size_t c = 0; c < 4; c++)
+			q[c][r] = s[r][col + c];
+	for (size_t c = 0; c < 4; c++)
+		for (size_t r = 0; r < 4; r++)
+			d[c][row + r] = q[c][r];
+#endif
+}
+
+/*
+	Transposes rows [r0, r1) x cols [c0, c1) of the source tile into the
+	destination tile, quads first, scalar edges after.
+*/
+void transposeBlock(double *const *src, size_t srcCol, double *const *dst, size_t dstCol,
+	size_t r0, size_t r1, size_t c0, size_t c1)
+{
+	size_t r = r0;
+	for (; r + 4 <= r1; r += 4)
+	{
+		const double *s[4] = {src[r] + srcCol, src[r + 1] + srcCol, src[r + 2] + srcCol, src[r + 3] + srcCol};
+		size_t c = c0;
+		for (; c + 4 <= c1; c += 4)
+		{
+			double *d[4] = {dst[c] + dstCol, dst[c + 1] + dstCol, dst[c + 2] + dstCol, dst[c + 3] + dstCol};
+			transpose4x4(s, c, d, r);
+		}
+		for (; c < c1; c++)
+			for (size_t k = 0; k < 4; k++)
+				dst[c][dstCol + r + k] = s[k][c];
+	}
+	for (; r < r1; r++)
+		for (size_t c = c0; c < c1; c++)
+			dst[c][dstCol + r] = src[r][srcCol + c];
+}
+
+/*
+	Swaps block (bi, bj) with the transpose of block (bj, bi) of a square
+	tile, bi < bj. Each side is first transposed into a local buffer.
+*/
+void swapBlocks(double *const *rows, size_t col, size_t bi, size_t bj, size_t n)
+{
+	double a[BLOCK][BLOCK];
+	double b[BLOCK][BLOCK];
+	double *aRows[BLOCK];
+	double *bRows[BLOCK];
+	for (size_t k = 0; k < BLOCK; k++)
+	{
+		aRows[k] = a[k];
+		bRows[k] = b[k];
+	}
+	size_t ri = bi * BLOCK, rj = bj * BLOCK;
+	size_t hi = std::min(BLOCK, n - ri), hj = std::min(BLOCK, n - rj);
+
+	// a = transpose of block (bi, bj): hj x hi, b = transpose of (bj, bi): hi x hj
+	transposeBlock(rows + ri, col + rj, aRows, 0, 0, hi, 0, hj);
+	transposeBlock(rows + rj, col + ri, bRows, 0, 0, hj, 0, hi);
+	for (size_t k = 0; k < hj; k++)
+		std::copy(a[k], a[k] + hi, rows[rj + k] + col + ri);
+	for (size_t k = 0; k < hi; k++)
+		std::copy(b[k], b[k] + hj, rows[ri + k] + col + rj);
+}
+
+void transposeDiagonalBlock(double *const *rows, size_t col, size_t bi, size_t n)
+{
+	size_t r0 = bi * BLOCK, r1 = std::min(n, r0 + BLOCK);
+	for (size_t i = r0; i < r1; i++)
+		for (size_t j = i + 1; j < r1; j++)
+			std::swap(rows[i][col + j], rows[j][col + i]);
+}
+
+void transposeSquareInPlace(double **rows, size_t startRow, size_t startCol, size_t n)
+{
+	double **tile = rows + startRow;
+	size_t blocks = (n + BLOCK - 1) / BLOCK;
+	ThreadPool::instance().parallelFor(0, blocks, BLOCK * n / 2, [&](size_t lo, size_t hi) {
+		for (size_t bi = lo; bi < hi; bi++)
+		{
+			transposeDiagonalBlock(tile, startCol, bi, n);
+			for (size_t bj = bi + 1; bj < blocks; bj++)
+				swapBlocks(tile, startCol, bi, bj, n);
+		}
+	});
+}
+
+void transposeTile(double **s, size_t srcCol, double **d, size_t dstCol, size_t rows, size_t cols)
+{
+	size_t blocks = (rows + BLOCK - 1) / BLOCK;
+	ThreadPool::instance().parallelFor(0, blocks, BLOCK * cols, [&](size_t lo, size_t hi) {
+		for (size_t bi = lo; bi < hi; bi++)
+		{
+			size_t r0 = bi * BLOCK, r1 = std::min(rows, r0 + BLOCK);
+			for (size_t c0 = 0; c0 < cols; c0 += BLOCK)
+				transposeBlock(s, srcCol, d, dstCol, r0, r1, c0, std::min(cols, c0 + BLOCK));
+		}
+	});
+}
+
+bool overlaps(const MatrixView& a, const MatrixView& b)
+{
+	if (a.matrix_ptr != b.matrix_ptr)
+		return false;
+	return a.getStartRow() < b.getStartRow() + b.getRows() && b.getStartRow() < a.getStartRow() + a.getRows()
+		&& a.getStartCol() < b.getStartCol() + b.getCols() && b.getStartCol() < a.getStartCol() + a.getCols();
+}
+
+}
+
+void transpose(const MatrixView& src, MatrixView& dst)
+{
+	size_t rows = src.getRows(), cols = src.getCols();
+	if (dst.getRows() != cols || dst.getCols() != rows)
+		throw std::invalid_argument("transpose dimensions do not match");
+	if (overlaps(src, dst))
+	{
+		if (src.getStartRow() == dst.getStartRow() && src.getStartCol() == dst.getStartCol() && rows == cols)
+		{
+			transposeInPlace(dst);
+			return;
+		}
+		throw std::invalid_argument("transpose source and destination overlap");
+	}
+
+	transposeTile(src.matrix_ptr + src.getStartRow(), src.getStartCol(),
+		dst.matrix_ptr + dst.getStartRow(), dst.getStartCol(), rows, cols);
+
+	dst.sum = src.sum;
+	dst.sumComputed = src.sumComputed;
+	dst.matrix.setSumComputed(false);
+	dst.matrix.markWritten(dst.getStartRow(), dst.getRows());
+}
+
+/*
+	The rows of m are read as stored and its pending scale is handed to
+	the result, which takes it lazily, so m itself is left untouched.
+*/
+Matrix transpose(const Matrix& m)
+{
+	Matrix result(m.getCols(), m.getRows());
+	transposeTile(m.getRawMatrix(), 0, result.getRawMatrix(), 0, m.getRows(), m.getCols());
+	result.markWritten(0, result.getRows());
+	result.scale(m.getPendingScale());
+	result.setSum(m.getSum());
+	result.setSumComputed(m.getSumComputed());
+	return result;
+}
+
+/*
+	The values are only permuted, so every cached sum stays valid.
+*/
+void transposeInPlace(MatrixView& view)
+{
+	if (view.getRows() != view.getCols())
+		throw std::invalid_argument("in-place transpose needs a square tile");
+	transposeSquareInPlace(view.matrix_ptr, view.getStartRow(), view.getStartCol(), view.getRows());
+	view.matrix.markWritten(view.getStartRow(), view.getRows());
+}
+
+void transposeInPlace(Matrix& m)
+{
+	if (m.getRows() != m.getCols())
+		throw std::invalid_argument("in-place transpose needs a square matrix");
+	// a pending scale applies to the permuted elements just the same
+	transposeSquareInPlace(m.getRawMatrix(), 0, 0, m.getRows());
+	m.markWritten(0, m.getRows());
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "../include/transpose.hpp"
+
+/**
+ * @brief Test the out-of-place transpose of views and matrices
+ *
+ * This test case verifies:
+ * 1. Every element lands at the mirrored position for non-square tiles
+ * 2. Sizes that are not multiples of the block or quad size are handled
+ * 3. The destination norm matches the source norm
+ * 4. Mismatched or overlapping destinations are rejected
+ */
+TEST(TransposeTest, OutOfPlace)
+{
+    Matrix m(70, 45);
+    for (size_t i = 0; i < 70; ++i)
+        for (size_t j = 0; j < 45; ++j)
+            m(i, j) = i * 100.0 + j;
+
+    Matrix t = transpose(m);
+    ASSERT_EQ(t.getRows(), 45);
+    ASSERT_EQ(t.getCols(), 70);
+    for (size_t i = 0; i < 70; ++i)
+        for (size_t j = 0; j < 45; ++j)
+            ASSERT_DOUBLE_EQ(t(j, i), m(i, j));
+
+    Matrix out(50, 50);
+    MatrixView src(m, 3, 5, 37, 33);
+    MatrixView dst(out, 2, 1, 33, 37);
+    transpose(src, dst);
+    for (size_t i = 0; i < 37; ++i)
+        for (size_t j = 0; j < 33; ++j)
+            ASSERT_DOUBLE_EQ(dst(j, i), src(i, j));
+    EXPECT_DOUBLE_EQ(out(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(dst.frobeniusNorm(), src.frobeniusNorm());
+
+    MatrixView wrong(out, 0, 0, 10, 10);
+    EXPECT_THROW(transpose(src, wrong), std::invalid_argument);
+    MatrixView a(m, 0, 0, 4, 8);
+    MatrixView b(m, 2, 2, 8, 4);
+    EXPECT_THROW(transpose(a, b), std::invalid_argument);
+}
+
+/**
+ * @brief Test the in-place transpose of square tiles and matrices
+ *
+ * This test case verifies:
+ * 1. A square matrix spanning several blocks is transposed in place
+ * 2. A square tile inside a larger matrix leaves the rest untouched
+ * 3. Non-square inputs are rejected
+ */
+TEST(TransposeTest, InPlace)
+{
+    Matrix m(75, 75);
+    for (size_t i = 0; i < 75; ++i)
+        for (size_t j = 0; j < 75; ++j)
+            m(i, j) = i * 100.0 + j;
+    transposeInPlace(m);
+    for (size_t i = 0; i < 75; ++i)
+        for (size_t j = 0; j < 75; ++j)
+            ASSERT_DOUBLE_EQ(m(i, j), j * 100.0 + i);
+
+    Matrix n(10, 12);
+    for (size_t i = 0; i < 10; ++i)
+        for (size_t j = 0; j < 12; ++j)
+            n(i, j) = i * 100.0 + j;
+    MatrixView tile(n, 1, 2, 7, 7);
+    transpose(tile, tile);
+    for (size_t i = 0; i < 7; ++i)
+        for (size_t j = 0; j < 7; ++j)
+            ASSERT_DOUBLE_EQ(tile(i, j), (j + 1) * 100.0 + (i + 2));
+    EXPECT_DOUBLE_EQ(n(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(n(9, 11), 911.0);
+
+    Matrix rect(3, 4);
+    EXPECT_THROW(transposeInPlace(rect), std::invalid_argument);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "../include/VersionedMatrix.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Test that snapshot tiles cannot write into shared blocks
+ *
+ * This test case verifies:
+ * 1. A snapshot tile has no conversion to a writable MatrixView
+ * 2. Its elements are returned by value
+ * 3. Writing into a copy of the tile leaves every version unchanged
+ */
+TEST(VersionedMatrixTest, ReadOnlySnapshotView)
+{
+    static_assert(!std::is_constructible<MatrixView, ConstMatrixView>::value,
+        "a snapshot tile must not convert to a MatrixView");
+    static_assert(std::is_same<decltype(std::declval<const ConstMatrixView &>()(0, 0)), double>::value,
+        "snapshot tile elements are returned by value");
+
+    VersionedMatrix vm(Matrix(8, 3, 2.0), 4);
+    VersionedMatrix::Snapshot before = vm.snapshot();
+    vm.setValue(7, 0, 5.0);
+    vm.publish();
+    VersionedMatrix::Snapshot after = vm.snapshot();
+
+    ConstMatrixView tile = before.view(0, 0, 4, 3);
+    ConstMatrixView copied = tile;
+    Matrix written = copied.toMatrix();
+    written(0, 0) = 100.0;
+    EXPECT_DOUBLE_EQ(copied(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(before.matrix()(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(after.matrix()(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(after.view(4, 0, 4, 3).getValue(3, 0), 5.0);
+    EXPECT_THROW(tile.getValue(4, 0), std::out_of_range);
+    EXPECT_THROW(after.view(5, 0, 4, 3), std::out_of_range);
+}
+
+/**
+ * @brief Test snapshot isolation of the VersionedMatrix class
+ *
+ * This test case verifies:
+ * 1. Pending writes are invisible to readers until publish()
+ * 2. A pinned snapshot keeps seeing its version after later publishes
+ * 3. The snapshot norm is the exact norm of its version
+ * 4. Retired versions are reclaimed once their snapshots are released
+ */
+TEST(VersionedMatrixTest, SnapshotIsolation)
+{
+    Matrix initial(10, 4, 1.0);
+    VersionedMatrix vm(initial, 4);
+
+    VersionedMatrix::Snapshot before = vm.snapshot();
+    EXPECT_DOUBLE_EQ(before.frobeniusNorm(), std::sqrt(40.0));
+
+    vm.setValue(5, 2, 3.0);
+    EXPECT_DOUBLE_EQ(vm.getValue(5, 2), 3.0);
+    EXPECT_DOUBLE_EQ(before.matrix()(5, 2), 1.0);
+
+    vm.publish();
+    VersionedMatrix::Snapshot after = vm.snapshot();
+    EXPECT_DOUBLE_EQ(after.matrix()(5, 2), 3.0);
+    EXPECT_DOUBLE_EQ(after.frobeniusNorm(), std::sqrt(48.0));
+    EXPECT_DOUBLE_EQ(before.matrix()(5, 2), 1.0);
+    EXPECT_DOUBLE_EQ(before.frobeniusNorm(), std::sqrt(40.0));
+
+    // untouched blocks are shared between versions
+    EXPECT_EQ(before.matrix().getMatrix()[0], after.matrix().getMatrix()[0]);
+    EXPECT_NE(before.matrix().getMatrix()[5], after.matrix().getMatrix()[5]);
+
+    ConstMatrixView tile = after.view(4, 1, 2, 2);
+    EXPECT_DOUBLE_EQ(tile.frobeniusNorm(), std::sqrt(12.0));
+
+    EXPECT_EQ(vm.getRetiredCount(), 1);
+    before = vm.snapshot();
+    vm.reclaim();
+    EXPECT_EQ(vm.getRetiredCount(), 0);
+}
+
+/**
+ * @brief Test readers running concurrently with the writer
+ *
+ * This test case verifies:
+ * 1. Readers never observe a half-applied update
+ * 2. Every snapshot sees a single epoch value across all blocks
+ */
+TEST(VersionedMatrixTest, ConcurrentReaders)
+{
+    VersionedMatrix vm(32, 8, 4);
+    std::atomic<bool> done(false);
+    std::atomic<int> torn(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&]() {
+            while (!done.load())
+            {
+                VersionedMatrix::Snapshot snap = vm.snapshot();
+                const Matrix &m = snap.matrix();
+                double first = m(0, 0);
+                for (size_t i = 0; i < m.getRows(); ++i)
+                    for (size_t j = 0; j < m.getCols(); ++j)
+                        if (m(i, j) != first)
+                            torn++;
+            }
+        });
+    }
+
+    for (int k = 1; k <= 200; ++k)
+    {
+        for (size_t i = 0; i < vm.getRows(); ++i)
+            for (size_t j = 0; j < vm.getCols(); ++j)
+                vm.setValue(i, j, k);
+        vm.publish();
+    }
+    done.store(true);
+    for (std::thread &t : readers)
+        t.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    VersionedMatrix::Snapshot last = vm.snapshot();
+    EXPECT_DOUBLE_EQ(last.frobeniusNorm(), std::sqrt(200.0 * 200.0 * 32 * 8));
+}
+
+/**
+ * @brief Test the reader limit of the VersionedMatrix class
+ *
+ * This test case verifies:
+ * 1. A snapshot beyond maxReaders waits instead of failing
+ * 2. It is granted once another snapshot is released
+ */
+TEST(VersionedMatrixTest, ReaderLimit)
+{
+    VersionedMatrix vm(4, 4, 2, 2);
+    VersionedMatrix::Snapshot first = vm.snapshot();
+    VersionedMatrix::Snapshot second = vm.snapshot();
+
+    std::atomic<bool> pinned(false);
+    std::thread late([&]() {
+        VersionedMatrix::Snapshot third = vm.snapshot();
+        pinned.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pinned.load());
+
+    first = std::move(second);
+    late.join();
+    EXPECT_TRUE(pinned.load());
+}
@@ -0,0 +1,222 @@
+#include "../include/viewAssign.hpp"
+#include "../include/ThreadPool.hpp"
+#include "../include/rowKernels.hpp"
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// sums of squares of the two sides of a copy or swap
+typedef std::pair<double, double> SumPair;
+
+SumPair addPairs(SumPair a, SumPair b)
+{
+	return SumPair(a.first + b.first, a.second + b.second);
+}
+
+/*
+	Single pass kernels over disjoint spans. Four accumulators per sum
+	keep the reductions off the critical path, so the loops vectorise like
+	a plain copy.
+*/
+
+// dst = src, returns the old sum of squares of dst and that of src
+SumPair assignSpan(double *__restrict dst, const double *__restrict src, size_t n)
+{
+	double b0 = 0, b1 = 0, b2 = 0, b3 = 0;
+	double a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+	size_t j = 0;
+	for (; j + 4 <= n; j += 4)
+	{
+		b0 += dst[j] * dst[j];
+		b1 += dst[j + 1] * dst[j + 1];
+		b2 += dst[j + 2] * dst[j + 2];
+		b3 += dst[j + 3] * dst[j + 3];
+		a0 += src[j] * src[j];
+		a1 += src[j + 1] * src[j + 1];
+		a2 += src[j + 2] * src[j + 2];
+		a3 += src[j + 3] * src[j + 3];
+		dst[j] = src[j];
+		dst[j + 1] = src[j + 1];
+		dst[j + 2] = src[j + 2];
+		dst[j + 3] = src[j + 3];
+	}
+	for (; j < n; j++)
+	{
+		b0 += dst[j] * dst[j];
+		a0 += src[j] * src[j];
+		dst[j] = src[j];
+	}
+	return SumPair((b0 + b1) + (b2 + b3), (a0 + a1) + (a2 + a3));
+}
+
+// returns the old sums of squares of a and b
+SumPair swapSpans(double *__restrict a, double *__restrict b, size_t n)
+{
+	double s0 = 0, s1 = 0, t0 = 0, t1 = 0;
+	size_t j = 0;
+	for (; j + 2 <= n; j += 2)
+	{
+		double x0 = a[j], x1 = a[j + 1];
+		double y0 = b[j], y1 = b[j + 1];
+		s0 += x0 * x0;
+		s1 += x1 * x1;
+		t0 += y0 * y0;
+		t1 += y1 * y1;
+		a[j] = y0;
+		a[j + 1] = y1;
+		b[j] = x0;
+		b[j + 1] = x1;
+	}
+	for (; j < n; j++)
+	{
+		double x = a[j], y = b[j];
+		s0 += x * x;
+		t0 += y * y;
+		a[j] = y;
+		b[j] = x;
+	}
+	return SumPair(s0 + s1, t0 + t1);
+}
+
+// returns the old sum of squares of row
+double fillSpan(double *row, size_t n, double value)
+{
+	double before = sumOfSquares(row, n);
+	for (size_t j = 0; j < n; j++)
+		row[j] = value;
+	return before;
+}
+
+// rows already offset to the first row of each tile
+SumPair assignRows(double **dst, size_t dstCol, double **src, size_t srcCol, size_t rows, size_t cols)
+{
+	return ThreadPool::instance().parallelReduce(0, rows, cols, SumPair(0, 0),
+		[=](size_t lo, size_t hi) {
+			SumPair total(0, 0);
+			for (size_t i = lo; i < hi; i++)
+				total = addPairs(total, assignSpan(dst[i] + dstCol, src[i] + srcCol, cols));
+			return total;
+		}, addPairs);
+}
+
+// each row of src overlaps at most its own row of dst, rows stay independent
+SumPair moveRows(double **rows, size_t dstCol, size_t srcCol, size_t numRows, size_t cols)
+{
+	return ThreadPool::instance().parallelReduce(0, numRows, cols, SumPair(0, 0),
+		[=](size_t lo, size_t hi) {
+			SumPair total(0, 0);
+			for (size_t i = lo; i < hi; i++)
+			{
+				total.first += sumOfSquares(rows[i] + dstCol, cols);
+				total.second += sumOfSquares(rows[i] + srcCol, cols);
+				std::memmove(rows[i] + dstCol, rows[i] + srcCol, cols * sizeof(double));
+			}
+			return total;
+		}, addPairs);
+}
+
+bool sameRows(const MatrixView& a, const MatrixView& b)
+{
+	return a.matrix_ptr == b.matrix_ptr || (a.storage && a.storage == b.storage);
+}
+
+// conservative when the tiles reach the same rows through different tables
+bool overlaps(const MatrixView& a, const MatrixView& b)
+{
+	if (!sameRows(a, b))
+		return false;
+	if (a.matrix_ptr != b.matrix_ptr)
+		return true;
+	return a.startRow < b.startRow + b.rows && b.startRow < a.startRow + a.rows
+		&& a.startCol < b.startCol + b.cols && b.startCol < a.startCol + a.cols;
+}
+
+// the view cache becomes exact, the parent sum moves by the delta
+void commit(MatrixView& view, double before, double after)
+{
+	view.sum = after;
+	view.sumComputed = true;
+	if (view.storage)
+		view.storage->markWritten(view.startRow, view.startRow + view.rows);
+	view.matrix.addToSum(after - before);
+}
+
+void checkShapes(const MatrixView& a, const MatrixView& b, const char *what)
+{
+	if (a.rows != b.rows || a.cols != b.cols)
+		throw std::invalid_argument(what);
+}
+
+}
+
+void assign(MatrixView& dst, const MatrixView& src)
+{
+	checkShapes(dst, src, "assign dimensions do not match");
+	SumPair sums;
+	if (!overlaps(dst, src))
+		sums = assignRows(dst.matrix_ptr + dst.startRow, dst.startCol,
+			src.matrix_ptr + src.startRow, src.startCol, dst.rows, dst.cols);
+	else if (dst.matrix_ptr == src.matrix_ptr && dst.startRow == src.startRow)
+	{
+		if (dst.startCol == src.startCol)
+			return;
+		sums = moveRows(dst.matrix_ptr + dst.startRow, dst.startCol, src.startCol, dst.rows, dst.cols);
+	}
+	else
+	{
+		Matrix staged = Matrix::fromRows(src.matrix_ptr, src.startRow, src.startCol, src.rows, src.cols,
+			src.storage.get());
+		sums = assignRows(dst.matrix_ptr + dst.startRow, dst.startCol, staged.getRawMatrix(), 0, dst.rows, dst.cols);
+	}
+	commit(dst, sums.first, sums.second);
+}
+
+void fill(MatrixView& view, double value)
+{
+	double **rows = view.matrix_ptr;
+	size_t startCol = view.startCol, cols = view.cols;
+	double before = 0;
+	auto fillRange = [&](size_t first, size_t last) {
+		before += ThreadPool::instance().parallelReduce(first, last, cols, 0.0,
+			[=](size_t lo, size_t hi) {
+				double sum = 0;
+				for (size_t i = lo; i < hi; i++)
+					sum += fillSpan(rows[i] + startCol, cols, value);
+				return sum;
+			}, std::plus<double>());
+	};
+	if (value == 0 && view.storage)
+		view.storage->forEachWritten(view.startRow, view.startRow + view.rows, fillRange);
+	else
+		fillRange(view.startRow, view.startRow + view.rows);
+	if (value != 0)
+	{
+		commit(view, before, value * value * view.rows * view.cols);
+		return;
+	}
+	// untouched groups stay untouched
+	view.sum = 0;
+	view.sumComputed = true;
+	view.matrix.addToSum(-before);
+}
+
+void swapTiles(MatrixView& a, MatrixView& b)
+{
+	checkShapes(a, b, "swapTiles dimensions do not match");
+	if (overlaps(a, b))
+		throw std::invalid_argument("swapTiles tiles overlap");
+	double **ra = a.matrix_ptr + a.startRow, **rb = b.matrix_ptr + b.startRow;
+	size_t colA = a.startCol, colB = b.startCol, cols = a.cols;
+	SumPair sums = ThreadPool::instance().parallelReduce(0, a.rows, cols, SumPair(0, 0),
+		[=](size_t lo, size_t hi) {
+			SumPair total(0, 0);
+			for (size_t i = lo; i < hi; i++)
+				total = addPairs(total, swapSpans(ra[i] + colA, rb[i] + colB, cols));
+			return total;
+		}, addPairs);
+	commit(a, sums.first, sums.second);
+	commit(b, sums.second, sums.first);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../include/viewAssign.hpp"
+#include "test_matrices.hpp"
+#include <stdexcept>
+
+namespace {
+
+double rescan(Matrix &m)
+{
+    m.setSumComputed(false);
+    return m.frobeniusNorm();
+}
+
+}
+
+/**
+ * @brief Test tile assignment between and within matrices
+ *
+ * This test case verifies:
+ * 1. Disjoint tiles are copied element by element and the rest is left alone
+ * 2. Overlapping tiles on the same rows and on shifted rows behave as if the source was copied out first
+ * 3. The destination view and the parent norms match a full rescan
+ * 4. Mismatched dimensions throw
+ */
+TEST(ViewAssignTest, Assign)
+{
+    Matrix src = filledMatrix(60, 40);
+    Matrix dst(50, 50, 1.0);
+    dst.frobeniusNorm();
+    MatrixView from(src, 5, 3, 30, 20);
+    MatrixView to(dst, 10, 20, 30, 20);
+    assign(to, from);
+    for (size_t i = 0; i < 30; ++i)
+        for (size_t j = 0; j < 20; ++j)
+            ASSERT_DOUBLE_EQ(dst.getValue(10 + i, 20 + j), src.getValue(5 + i, 3 + j));
+    EXPECT_DOUBLE_EQ(dst.getValue(9, 20), 1.0);
+    EXPECT_DOUBLE_EQ(dst.getValue(10, 19), 1.0);
+    EXPECT_NEAR(to.frobeniusNorm(), from.frobeniusNorm(), 1e-12 * to.frobeniusNorm());
+    double cached = dst.frobeniusNorm();
+    EXPECT_NEAR(cached, rescan(dst), 1e-12 * cached);
+
+    Matrix m = filledMatrix(60, 40);
+    Matrix expected = m;
+    MatrixView right(m, 0, 5, 60, 30);
+    MatrixView left(m, 0, 0, 60, 30);
+    assign(left, right);
+    for (size_t i = 0; i < 60; ++i)
+        for (size_t j = 0; j < 30; ++j)
+            ASSERT_DOUBLE_EQ(m.getValue(i, j), expected.getValue(i, j + 5));
+
+    expected = m;
+    m.frobeniusNorm();
+    MatrixView upper(m, 0, 0, 40, 35);
+    MatrixView lower(m, 7, 2, 40, 35);
+    assign(lower, upper);
+    for (size_t i = 0; i < 40; ++i)
+        for (size_t j = 0; j < 35; ++j)
+            ASSERT_DOUBLE_EQ(m.getValue(7 + i, 2 + j), expected.getValue(i, j));
+    cached = m.frobeniusNorm();
+    EXPECT_NEAR(cached, rescan(m), 1e-12 * cached);
+
+    MatrixView wrong(dst, 0, 0, 30, 21);
+    EXPECT_THROW(assign(wrong, from), std::invalid_argument);
+}
+
+/**
+ * @brief Test tile fill and swap
+ *
+ * This test case verifies:
+ * 1. fill writes the value over the tile only and the norms follow
+ * 2. Filling with zero leaves untouched row groups untouched
+ * 3. swapTiles exchanges the elements of two tiles, across matrices too, and both norms follow
+ * 4. Overlapping or mismatched tiles are rejected by swapTiles
+ */
+TEST(ViewAssignTest, FillAndSwap)
+{
+    Matrix m = filledMatrix(40, 30);
+    m.frobeniusNorm();
+    MatrixView tile(m, 3, 4, 20, 10);
+    fill(tile, -2.5);
+    EXPECT_DOUBLE_EQ(m.getValue(3, 4), -2.5);
+    EXPECT_DOUBLE_EQ(m.getValue(22, 13), -2.5);
+    EXPECT_DOUBLE_EQ(m.getValue(23, 13), 2313.0);
+    EXPECT_DOUBLE_EQ(tile.frobeniusNorm(), 2.5 * std::sqrt(200.0));
+    double cached = m.frobeniusNorm();
+    EXPECT_NEAR(cached, rescan(m), 1e-12 * cached);
+
+    Matrix sparse(300, 8);
+    sparse(200, 1) = 3.0;
+    MatrixView all(sparse, 0, 0, 300, 8);
+    fill(all, 0.0);
+    EXPECT_TRUE(sparse.isUntouched(10));
+    EXPECT_DOUBLE_EQ(sparse.getValue(200, 1), 0.0);
+    EXPECT_DOUBLE_EQ(sparse.frobeniusNorm(), 0.0);
+
+    Matrix other(25, 25, 0.5);
+    other.frobeniusNorm();
+    Matrix before = m;
+    MatrixView a(m, 10, 0, 15, 12);
+    MatrixView b(other, 5, 5, 15, 12);
+    swapTiles(a, b);
+    for (size_t i = 0; i < 15; ++i)
+        for (size_t j = 0; j < 12; ++j)
+        {
+            ASSERT_DOUBLE_EQ(m.getValue(10 + i, j), 0.5);
+            ASSERT_DOUBLE_EQ(other.getValue(5 + i, 5 + j), before.getValue(10 + i, j));
+        }
+    cached = m.frobeniusNorm();
+    EXPECT_NEAR(cached, rescan(m), 1e-12 * cached);
+    cached = other.frobeniusNorm();
+    EXPECT_NEAR(cached, rescan(other), 1e-12 * cached);
+    EXPECT_DOUBLE_EQ(a.frobeniusNorm(), 0.5 * std::sqrt(180.0));
+
+    MatrixView c(m, 0, 0, 10, 10);
+    MatrixView d(m, 5, 5, 10, 10);
+    EXPECT_THROW(swapTiles(c, d), std::invalid_argument);
+    MatrixView e(m, 20, 20, 10, 9);
+    EXPECT_THROW(swapTiles(c, e), std::invalid_argument);
+}